@@ -0,0 +1,171 @@
+//
+// Copyright (c) 2026 suzumushi
+//
+// 2026-10-17		AQBLtables.h
+//
+// Licensed under Creative Commons Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0).
+//
+// https://creativecommons.org/licenses/by-nc-sa/4.0/
+//
+
+#pragma once
+
+#include <atomic>
+#include <cmath>
+#include <complex>
+#include <memory>
+#include <numbers>
+#include "AQparam.h"
+#include "SOFFT.h"
+
+
+namespace suzumushi {
+
+// Band-limited (mip-mapped) wave tables of triangle, square and sawtooth waves and their Hilbert
+// transformed partners
+//
+// The table set of level j contains the harmonics up to 2^j, and is selected by level () so that the
+// highest harmonic does not exceed SR / 2. For lower frequencies level () returns -1, and the naive
+// tables of AQDDS are used. The partner of a_k sin (kx) is - a_k cos (kx), the same as the sine carrier.
+// Tables are built once by build (), the first time a waveform other than sine is selected, outside of
+// the audio thread, and shared by all instances. get () returns nullptr until then. Each level is
+// synthesized from its spectrum by the inverse FFT of SOrealFFT. Each table holds pairs of the wave and
+// the partner, TBL [i + 1] at phase i / len (level), including guard entries for cubic interpolation.
+
+template <typename TYPE>
+class AQBLtables {
+public:
+	static constexpr int LEVELS = 10;			// 1 to 512 harmonics
+	struct entry {
+		TYPE yn;
+		TYPE yHn;
+	};
+	static void build ();						// outside of the audio thread, blocks until built
+	static const AQBLtables* get ()				// any thread, nullptr if not built yet
+	{
+		return (built.load (std::memory_order_acquire));
+	}
+	static int level (const double samplingRate, const double frequency);
+	static constexpr int len (const int level)	// table length, at least 8 points per cycle of the highest harmonic
+	{
+		return (8 << level < MIN_LEN ? MIN_LEN : 8 << level);
+	}
+	const entry* table (const WFORM_L waveform, const int level) const
+	{
+		return (tables [(int)waveform - (int)WFORM_L::TRIANGLE][level].get ());
+	}
+private:
+	static constexpr int MIN_LEN = 256;
+	AQBLtables ();
+	template <int LEVEL>
+	void synthesize ();							// levels LEVEL and above
+	static TYPE amplitude (const WFORM_L waveform, const int k);	// amplitude of k-th harmonic
+	std::unique_ptr <entry []> tables [3][LEVELS];	// triangle, square and sawtooth
+	static inline std::atomic <const AQBLtables*> built {nullptr};
+};
+
+template <typename TYPE>
+void
+AQBLtables <TYPE>:: 
+build ()
+{
+	static const AQBLtables tbls;				// initialized by only one thread
+	built.store (&tbls, std::memory_order_release);
+}
+
+template <typename TYPE>
+int
+AQBLtables <TYPE>:: 
+level (const double samplingRate, const double frequency)
+{
+	if (frequency <= 0.0 || samplingRate >= 2.0 * frequency * (1 << LEVELS))
+		return (-1);
+	int j = LEVELS - 1;
+	while (j > 0 && samplingRate < 2.0 * frequency * (1 << j))
+		j--;
+	return (j);
+}
+
+template <typename TYPE>
+TYPE
+AQBLtables <TYPE>:: 
+amplitude (const WFORM_L waveform, const int k)
+{
+	// amplitudes of AQDDS: triangle +/- sqrt (3), square +/- 1/2, sawtooth -1/2 to 1/2
+	if (waveform == WFORM_L::TRIANGLE)
+		return (k % 2 == 0 ? 0.0 : (k % 4 == 1 ? 1.0 : -1.0) * std::numbers::sqrt3 * 8.0 / (std::numbers::pi * std::numbers::pi * k * k));
+	else if (waveform == WFORM_L::SQUARE)
+		return (k % 2 == 0 ? 0.0 : 2.0 / (std::numbers::pi * k));
+	else
+		return ((k % 2 == 0 ? -1.0 : 1.0) / (std::numbers::pi * k));
+}
+
+template <typename TYPE>
+AQBLtables <TYPE>:: 
+AQBLtables ()
+{
+	synthesize <0> ();
+}
+
+template <typename TYPE>
+template <int LEVEL>
+void
+AQBLtables <TYPE>:: 
+synthesize ()
+{
+	// levels of the same table length share a transform
+	constexpr int L = len (LEVEL);
+	constexpr int NEXT = [] {
+		int j = LEVEL;
+		while (j < LEVELS && len (j) == L)
+			j++;
+		return (j);
+	} ();
+	auto FFT = std::make_unique <SOrealFFT <double, L>> ();
+	auto Xk = std::make_unique <std::complex <double> []> (L / 2 + 1);
+	auto odd_k = std::make_unique <double []> (L);		// triangle + even harmonics of sawtooth
+	auto squ = std::make_unique <double []> (L);
+
+	// a_k sin (kx) is the bin -j a_k L/2 and - a_k cos (kx) is the bin - a_k L/2 of the inverse FFT, and
+	// their sum is split into the odd function of x (the wave) and the even function (the partner).
+	// Triangle and square waves have only odd harmonics, and the sawtooth wave is the half of the square
+	// wave plus even harmonics, which share a transform with the triangle wave and are split by x + pi.
+	auto spectrum = [&Xk] (const int harmonics, auto&& a) {
+		for (int k = 0; k <= L / 2; k++)
+			Xk [k] = 0.0;
+		for (int k = 1; k <= harmonics; k++)
+			Xk [k] = {- a (k) * L / 2, - a (k) * L / 2};
+	};
+	for (int j = LEVEL; j < NEXT; j++) {
+		spectrum (1 << j, [] (const int k) {
+			return (amplitude (k % 2 ? WFORM_L::TRIANGLE : WFORM_L::SAWTOOTH, k));
+		});
+		FFT->inverse (Xk.get (), odd_k.get ());
+		spectrum (1 << j, [] (const int k) {
+			return (amplitude (WFORM_L::SQUARE, k));
+		});
+		FFT->inverse (Xk.get (), squ.get ());
+
+		entry* TBL [3];
+		for (int w = 0; w < 3; w++) {
+			tables [w][j].reset (new entry [L + 3]);
+			TBL [w] = tables [w][j].get ();
+		}
+		for (int i = 0; i < L + 3; i++) {
+			const int p = (i + L - 1) % L;
+			const int m = (L - p) % L;						// - x
+			const int h = (p + L / 2) % L;					// x + pi
+			const int mh = (m + L / 2) % L;					// - x + pi
+			const double tri = odd_k [p] - odd_k [h], tri_m = odd_k [m] - odd_k [mh];		// 2 x triangle
+			const double even = odd_k [p] + odd_k [h], even_m = odd_k [m] + odd_k [mh];	// 2 x even harmonics
+			const double s = squ [p] - squ [m], sH = squ [p] + squ [m];					// 2 x square
+			TBL [0][i] = {(TYPE)((tri - tri_m) * 0.25), (TYPE)((tri + tri_m) * 0.25)};
+			TBL [1][i] = {(TYPE)(s * 0.5), (TYPE)(sH * 0.5)};
+			TBL [2][i] = {(TYPE)((s + even - even_m) * 0.25), (TYPE)((sH + even + even_m) * 0.25)};
+		}
+	}
+	if constexpr (NEXT < LEVELS)
+		synthesize <NEXT> ();
+}
+
+} // namespace suzumushi
@@ -0,0 +1,113 @@
+//
+// Copyright (c) 2026 suzumushi
+//
+// 2026-10-17		AQBPHilbert.h
+//
+// Licensed under Creative Commons Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0).
+//
+// https://creativecommons.org/licenses/by-nc-sa/4.0/
+//
+
+#pragma once
+
+#include "AQHilbert.h"
+#include "SODDL.h"
+#include "SOSIMD.h"
+
+
+namespace suzumushi {
+
+// Multichannel band-pass Hilbert transformer (linear phase input HPF merged into the Hilbert pair)
+//
+// set_coefs () convolves the impulse response of the HPF (HPF_LEN taps) with the in-phase (pure delay)
+// and quadrature (AQHilbert) responses, and yn and yHn are computed by one FIR pass on one interleaved
+// mirrored delay line. The group delay IR_CENTER + (HPF_LEN - 1) / 2 is the same as the HPF followed by
+// AQHilbert, and so is the output within rounding errors.
+// The in-phase response is the HPF itself, and only its HPF_LEN taps are convolved. The quadrature
+// response is dense (IR_LEN + HPF_LEN - 1 taps), whereas the cascade needs HPF_LEN + (IR_LEN + 1) / 2.
+// set_coefs () costs (IR_LEN + 1) / 2 * HPF_LEN multiplications.
+//
+// Per-frame cost (x86-64, double, stereo, relative to AQFIRfilters followed by AQMCHilbert):
+//	IR_LEN = 259	2.16 (SSE2)		1.53 (AVX2)
+//	IR_LEN = 771	2.37 (SSE2)		1.76 (AVX2)
+// i.e. the saved delay line does not pay for the dense quadrature response.
+
+template <typename TYPE,
+	int CH = 2,									// number of channels
+	int IR_LEN = 259,							// Logical length of impulse response of Hilbert transformer
+	int HPF_LEN = 131,							// Length of impulse response of HPF
+	int BP_LEN = IR_LEN + HPF_LEN - 1,			// Length of merged impulse response (don't touch this)
+	int PAD_LEN = (BP_LEN + SO_SIMD_WIDTH - 1) / SO_SIMD_WIDTH * SO_SIMD_WIDTH,		// (don't touch this)
+	int HPF_PAD_LEN = (HPF_LEN + SO_SIMD_WIDTH - 1) / SO_SIMD_WIDTH * SO_SIMD_WIDTH>	// (don't touch this)
+class AQBPHilbert {
+public:
+	void set_coefs (const TYPE* hpf_ir);		// hpf_ir [HPF_LEN]
+	void process (const TYPE* xn, TYPE* yn, TYPE* yHn);		// xn [CH], yn [CH], yHn [CH]
+	void process (const TYPE* const* xn, TYPE* const* yn, TYPE* const* yHn, const int len);	// xn [CH][len], ...
+	void reset ();
+private:
+	static constexpr int IR_CENTER = (IR_LEN - 1) / 2;
+	static constexpr int PAD = PAD_LEN - BP_LEN;			// zero taps at the oldest end
+	static constexpr int I_OFFSET = PAD + IR_CENTER;		// the oldest tap of in-phase response in window
+	static_assert (I_OFFSET + HPF_PAD_LEN <= PAD_LEN, "in-phase window exceeds the delay line");
+	alignas (64) TYPE I_TBL [HPF_PAD_LEN] {};	// in-phase response (the oldest first)
+	alignas (64) TYPE Q_TBL [PAD_LEN] {};		// quadrature response (the oldest first)
+	SOMDDL <TYPE, PAD_LEN * CH> IDL;			// Interleaved input delay line
+};
+
+template <typename TYPE, int CH, int IR_LEN, int HPF_LEN, int BP_LEN, int PAD_LEN, int HPF_PAD_LEN>
+void
+AQBPHilbert <TYPE, CH, IR_LEN, HPF_LEN, BP_LEN, PAD_LEN, HPF_PAD_LEN>::
+set_coefs (const TYPE* hpf_ir)
+{
+	// non-zero taps of AQHilbert, the oldest first: - IR_TBL [i / 2] at i and IR_TBL [i / 2] at IR_LEN - 1 - i
+	constexpr std::array <TYPE, (IR_LEN + 1) / 4> IR_TBL = AQHilbert_IR_TBL <TYPE, IR_LEN> ();
+	for (int k = 0; k < PAD_LEN; k++)
+		Q_TBL [k] = 0.0;
+	for (int i = 0; i < IR_CENTER; i += 2)
+		for (int m = 0; m < HPF_LEN; m++) {
+			Q_TBL [PAD + i + m] -= IR_TBL [i / 2] * hpf_ir [m];
+			Q_TBL [PAD + IR_LEN - 1 - i + m] += IR_TBL [i / 2] * hpf_ir [m];
+		}
+	for (int m = 0; m < HPF_LEN; m++)
+		I_TBL [m] = hpf_ir [m];
+}
+
+template <typename TYPE, int CH, int IR_LEN, int HPF_LEN, int BP_LEN, int PAD_LEN, int HPF_PAD_LEN>
+void
+AQBPHilbert <TYPE, CH, IR_LEN, HPF_LEN, BP_LEN, PAD_LEN, HPF_PAD_LEN>::
+process (const TYPE* xn, TYPE* yn, TYPE* yHn)
+{
+	for (int k = 0; k < CH; k++)
+		IDL.enqueue (xn [k]);
+	const TYPE* window = IDL.window ().data ();
+	SOdot_interleaved <TYPE, HPF_PAD_LEN, CH> (I_TBL, window + I_OFFSET * CH, yn);
+	SOdot_interleaved <TYPE, PAD_LEN, CH> (Q_TBL, window, yHn);
+}
+
+template <typename TYPE, int CH, int IR_LEN, int HPF_LEN, int BP_LEN, int PAD_LEN, int HPF_PAD_LEN>
+void
+AQBPHilbert <TYPE, CH, IR_LEN, HPF_LEN, BP_LEN, PAD_LEN, HPF_PAD_LEN>::
+process (const TYPE* const* xn, TYPE* const* yn, TYPE* const* yHn, const int len)
+{
+	for (int i = 0; i < len; i++) {
+		TYPE x [CH], y [CH], yH [CH];
+		for (int k = 0; k < CH; k++)
+			x [k] = xn [k][i];
+		process (x, y, yH);
+		for (int k = 0; k < CH; k++) {
+			yn [k][i] = y [k];
+			yHn [k][i] = yH [k];
+		}
+	}
+}
+
+template <typename TYPE, int CH, int IR_LEN, int HPF_LEN, int BP_LEN, int PAD_LEN, int HPF_PAD_LEN>
+void
+AQBPHilbert <TYPE, CH, IR_LEN, HPF_LEN, BP_LEN, PAD_LEN, HPF_PAD_LEN>::
+reset ()
+{
+	IDL.reset ();
+}
+
+} // namespace suzumushi
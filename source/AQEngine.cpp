@@ -0,0 +1,818 @@
+//
+// Copyright (c) 2026 suzumushi
+//
+// 2026-10-17		AQEngine.cpp
+//
+// Licensed under Creative Commons Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0).
+//
+// https://creativecommons.org/licenses/by-nc-sa/4.0/
+//
+
+#include "AQEngine.h"
+#include <algorithm>
+#include <cmath>
+
+
+namespace suzumushi {
+
+void AQEngine:: start ()
+{
+	designer.start ();
+}
+
+void AQEngine:: stop ()
+{
+	designer.stop ();
+}
+
+void AQEngine:: setup (const double sampling_rate, const bool realtime)
+{
+	// fill coefficient caches for the new sampling rate in the background
+	this->sampling_rate = sampling_rate;
+	this->realtime = realtime;
+	if (PREWARM_COEF_CACHE && realtime)
+		designer.request_design ({sampling_rate, gp.i_h_freq, gp.i_l_freq, gp.o_h_freq, gp.o_l_freq, Designer::PREWARM});
+}
+
+void AQEngine:: set_channels (const int32 ch)
+{
+	// called outside of the audio thread, followed by activate ()
+	channels = std::clamp (ch, 1, MAX_CHANNELS);
+	lanes = (channels + LANES - 1) / LANES * LANES;
+	DDL.resize (channels);
+	HT_IIR.resize (channels);
+	I_HPF.resize (channels);
+	HT_DRAFT.resize (lanes / LANES);
+	HT_NORMAL.resize (lanes / LANES);
+	HT_HIGH.resize (lanes / LANES);
+	HT_EXACT.resize (lanes / LANES);
+	BP_DRAFT.resize (MERGED_INPUT_HPF ? lanes / LANES : 0);
+	BP_NORMAL.resize (MERGED_INPUT_HPF ? lanes / LANES : 0);
+	BP_HIGH.resize (MERGED_INPUT_HPF ? lanes / LANES : 0);
+	BP_EXACT.resize (MERGED_INPUT_HPF ? lanes / LANES : 0);
+}
+
+void AQEngine:: activate ()
+{
+	reset ();
+	if (gp.wform != (int32)WFORM_L::SINE)
+		AQBLtables <double>::build ();
+	// initial coefficients are designed here, outside of the audio thread
+	Designer::coef_set coefs;
+	Designer::design ({sampling_rate, gp.i_h_freq, gp.i_l_freq, gp.o_h_freq, gp.o_l_freq, Designer::ALL}, coefs);
+	apply_coefs (coefs);
+}
+
+int32 AQEngine:: latency () const
+{
+	// dry path is delayed to align with wet path in linear phase mode
+	static_assert (fir_latency ((int32)HT_QUALITY_L::EXACT) <= suzumushi::latency.max, "latency parameter is too short");
+	if (gp.ht_mode == (int32)HT_MODE_L::LOW_LATENCY)
+		return (0);
+	else
+		return (fir_latency (gp.ht_quality));
+}
+
+void AQEngine:: load (const GUI_param& param)
+{
+	// values of a corrupt state are clamped like set_param (), since list items are used as indices
+	auto range = [] (const ParamValue value, const auto& attr) {
+		return (std::clamp (value, attr.min, attr.max));
+	};
+	auto list = [] (const int32 value, const auto len) {
+		return (std::clamp (value, 0, (int32)len - 1));
+	};
+	gp.c_freq = range (param.c_freq, c_freq);
+	gp.wform = list (param.wform, WFORM_L::LIST_LEN);
+	gp.auto_bl = list (param.auto_bl, AUTO_BL_L::LIST_LEN);
+	gp.c_slide = range (param.c_slide, c_slide);
+	gp.c_range = list (param.c_range, C_RANGE_L::LIST_LEN);
+	gp.c_scale = list (param.c_scale, C_SCALE_L::LIST_LEN);
+	gp.i_h_freq = range (param.i_h_freq, i_h_freq);
+	gp.i_l_freq = range (param.i_l_freq, i_l_freq);
+	gp.o_h_freq = range (param.o_h_freq, o_h_freq);
+	gp.o_l_freq = range (param.o_l_freq, o_l_freq);
+	gp.wet = range (param.wet, wet);
+	gp.dry = 1.0 - gp.wet;
+	gp.bypass = param.bypass != 0;
+	gp.ht_mode = list (param.ht_mode, HT_MODE_L::LIST_LEN);
+	gp.ht_quality = list (param.ht_quality, HT_QUALITY_L::LIST_LEN);
+	gp.mod_src = list (param.mod_src, MOD_SRC_L::LIST_LEN);
+	gp.mod_shape = list (param.mod_shape, MOD_SHAPE_L::LIST_LEN);
+	gp.mod_rate = range (param.mod_rate, mod_rate);
+	gp.mod_depth = range (param.mod_depth, mod_depth);
+
+	reset ();
+	if constexpr (MERGED_INPUT_HPF)
+		bp_set_coefs ();
+}
+
+void AQEngine:: set_param (const ParamID id, const ParamValue value)
+{
+	auto range = [value] (const auto& param) {
+		return (std::clamp (value, param.min, param.max));
+	};
+	auto list = [value] (const int32 len) {
+		return (std::clamp ((int32)std::lround (value), 0, len - 1));
+	};
+	ParamValue update;
+
+	switch (id) {
+		case c_freq.tag:
+			set_c_freq (range (c_freq));
+			break;
+		case wform.tag:
+			gp.wform = list ((int32)WFORM_L::LIST_LEN);
+			break;
+		case auto_bl.tag:
+			gp.auto_bl = list ((int32)AUTO_BL_L::LIST_LEN);
+			break;
+		case c_slide.tag:
+			update = range (c_slide);
+			if (gp.c_slide != update) {
+				double sgn = gp.c_slide * update;
+				if (sgn < 0.0 || (sgn == 0.0 && (gp.c_slide < 0.0 || update < 0.0)))
+					gp.c_sb_switching = true;		// side band switching
+				gp.c_slide = update;
+				gp.c_slide_changed = true;
+			}
+			break;
+		case c_range.tag:
+			update = list ((int32)C_RANGE_L::LIST_LEN);
+			if (gp.c_range != update) {
+				gp.c_range = update;
+				gp.c_range_changed = true;
+			}
+			break;
+		case c_scale.tag:
+			update = list ((int32)C_SCALE_L::LIST_LEN);
+			if (gp.c_scale != update) {
+				gp.c_scale = update;
+				gp.c_scale_changed = true;
+			}
+			break;
+		case i_h_freq.tag:
+			update = range (i_h_freq);
+			if (gp.i_h_freq != update) {
+				gp.i_h_freq = update;
+				gp.i_h_freq_changed = true;
+			}
+			break;
+		case i_l_freq.tag:
+			update = range (i_l_freq);
+			if (gp.i_l_freq != update) {
+				gp.i_l_freq = update;
+				gp.i_l_freq_changed = true;
+			}
+			break;
+		case o_h_freq.tag:
+			update = range (o_h_freq);
+			if (gp.o_h_freq != update) {
+				gp.o_h_freq = update;
+				gp.o_h_freq_changed = true;
+			}
+			break;
+		case o_l_freq.tag:
+			update = range (o_l_freq);
+			if (gp.o_l_freq != update) {
+				gp.o_l_freq = update;
+				gp.o_l_freq_changed = true;
+			}
+			break;
+		case wet.tag:
+			gp.wet = range (wet);
+			gp.dry = 1.0 - gp.wet;
+			break;
+		case ht_mode.tag:
+			update = list ((int32)HT_MODE_L::LIST_LEN);
+			if (gp.ht_mode != update) {
+				gp.ht_mode = update;
+				reset ();
+			}
+			break;
+		case ht_quality.tag:
+			update = list ((int32)HT_QUALITY_L::LIST_LEN);
+			if (gp.ht_quality != update) {
+				gp.ht_quality = update;
+				ht_reset ();			// discard the stale history of the new quality
+				update_tail ();
+				if constexpr (MERGED_INPUT_HPF)
+					bp_set_coefs ();
+			}
+			break;
+		case mod_src.tag:
+			gp.mod_src = list ((int32)MOD_SRC_L::LIST_LEN);
+			gp.mod_changed = true;
+			break;
+		case mod_shape.tag:
+			gp.mod_shape = list ((int32)MOD_SHAPE_L::LIST_LEN);
+			gp.mod_changed = true;
+			break;
+		case mod_rate.tag:
+			gp.mod_rate = range (mod_rate);
+			gp.mod_changed = true;
+			break;
+		case mod_depth.tag:
+			gp.mod_depth = range (mod_depth);
+			gp.mod_changed = true;
+			break;
+		case bypass.tag:
+			gp.bypass = value != 0.0;
+			if (! gp.bypass)
+				reset ();
+			break;
+	}
+}
+
+void AQEngine:: set_c_freq (const ParamValue update)
+{
+	if (gp.c_freq != update) {
+		double sgn = gp.c_freq * update;
+		if (sgn < 0.0 || (sgn == 0.0 && (gp.c_freq < 0.0 || update < 0.0)))
+			gp.c_sb_switching = true;		// side band switching
+		gp.c_freq = update;
+		gp.c_freq_changed = true;
+	}
+}
+
+int AQEngine:: update ()
+{
+	int feedback = 0;
+
+	if (gp.reset || gp.c_freq_changed || gp.c_range_changed || gp.c_scale_changed) {
+		gp.c_range_changed = gp.c_scale_changed = gp.c_slide_changed = false;
+
+		if (gp.reset || gp.c_freq_changed) {
+			gp.c_freq_changed = true;
+			carrier_setup (std::abs (gp.c_freq));
+		}
+
+		if (gp.c_freq >= c_range_val [gp.c_range])
+			gp.c_slide = 1.0;
+		else if (gp.c_freq <= - c_range_val [gp.c_range])
+			gp.c_slide = -1.0;
+		else {
+			if (gp.c_scale == (int32)C_SCALE_L::LINEAR)
+				gp.c_slide = std::abs (gp.c_freq) / c_range_val [gp.c_range];
+			else					// Logarithmic
+				gp.c_slide = logTaperParameter::toNormalized (std::abs (gp.c_freq), 0.0, c_range_val [gp.c_range]);
+			if (gp.c_freq < 0.0)
+				gp.c_slide = - gp.c_slide;
+		}
+		feedback |= FB_C_SLIDE;
+	}
+
+	if (gp.c_slide_changed) {
+		gp.c_slide_changed = false;
+		gp.c_freq_changed = true;
+		if (gp.c_scale == (int32)C_SCALE_L::LINEAR)
+			gp.c_freq = std::abs (gp.c_slide) * c_range_val [gp.c_range];
+		else						// Logarithmic
+			gp.c_freq = logTaperParameter::toPlain (std::abs (gp.c_slide), 0.0, c_range_val [gp.c_range]);
+		carrier_setup (gp.c_freq);
+		if (gp.c_slide < 0.0)
+			gp.c_freq = - gp.c_freq;
+		feedback |= FB_C_FREQ;
+	}
+
+	if (gp.c_freq_changed && gp.auto_bl == (int32)AUTO_BL_L::AUTOMATIC) {
+		if (gp.wform == (int32)WFORM_L::SINE) {
+			if (gp.c_freq < 0.0)
+				gp.i_h_freq = std::max (300.0 - gp.c_freq, i_h_freq.min);
+			else
+				gp.i_h_freq = i_h_freq.min;
+			gp.i_h_freq_changed = true;
+			feedback |= FB_I_H_FREQ;
+		} else {
+			gp.i_l_freq = std::max (std::abs (gp.c_freq), i_l_freq.min);
+			gp.i_l_freq_changed = true;
+			feedback |= FB_I_L_FREQ;
+		}
+	}
+	gp.c_freq_changed = false;
+
+	if (gp.reset || gp.i_h_freq_changed) {
+		gp.i_h_freq_changed = false;
+		design_targets |= Designer::I_HPF;
+	}
+
+	if (gp.reset || gp.i_l_freq_changed) {
+		gp.i_l_freq_changed = false;
+		design_targets |= Designer::I_LPF;
+	}
+
+	if (gp.reset || gp.o_h_freq_changed) {
+		gp.o_h_freq_changed = false;
+		design_targets |= Designer::O_HPF;
+	}
+
+	if (gp.reset || gp.o_l_freq_changed) {
+		gp.o_l_freq_changed = false;
+		design_targets |= Designer::O_LPF;
+	}
+
+	if (gp.reset || gp.mod_changed) {
+		gp.mod_changed = false;
+		MOD.setup (sampling_rate, gp.mod_src, gp.mod_shape, gp.mod_rate, gp.mod_depth);
+	}
+
+	gp.reset = false;
+
+	// band-limited tables are built in the background the first time a waveform other than sine is selected
+	if (gp.wform != (int32)WFORM_L::SINE && ! bl_requested) {
+		bl_requested = true;
+		if (! AQBLtables <double>::get ())
+			design_targets |= Designer::BL_TABLES;
+	}
+
+	// filter coefficients are designed in the background and applied when they are ready
+	Designer::coef_set coefs;
+	if (design_targets != 0 && ! realtime) {
+		Designer::design ({sampling_rate, gp.i_h_freq, gp.i_l_freq, gp.o_h_freq, gp.o_l_freq, design_targets}, coefs);
+		apply_coefs (coefs);
+		design_targets = 0;
+	} else if (design_targets != 0)
+		if (designer.request_design ({sampling_rate, gp.i_h_freq, gp.i_l_freq, gp.o_h_freq, gp.o_l_freq, design_targets}))
+			design_targets = 0;			// otherwise, requested again in the next update ()
+	while (designer.fetch (coefs))
+		if (coefs.SR == sampling_rate)	// otherwise, requested before setup () for another sampling rate
+			apply_coefs (coefs);
+
+	return (feedback);
+}
+
+template <typename SAMPLE>
+uint64 AQEngine:: process (const SAMPLE* const* in, SAMPLE* const* out, const int32 len, const uint64 in_silence,
+	const double c_freq_end, const double wet_end)
+{
+	// the phase of the carrier is handed over when mod_src or wform changes its generator
+	if (carrier_select () != carrier)
+		carrier_handover ();
+	if (c_freq_end != gp.c_freq && ! gp.bypass)
+		carrier_ramp (std::abs (c_freq_end), len);
+
+	uint64 silence = dsp_process (in, out, len, in_silence, wet_end);
+
+	gp.wet = wet_end;
+	gp.dry = 1.0 - gp.wet;
+	if (c_freq_end != gp.c_freq)
+		set_c_freq (c_freq_end);
+	return (silence);
+}
+
+template <typename SAMPLE>
+uint64 AQEngine:: dsp_process (const SAMPLE* const* in, SAMPLE* const* out, const int32 len, const uint64 in_silence, const double wet_end)
+{
+	uint64 silence = ((uint64)1 << channels) - 1;	// cleared for non-silent channels
+	if (len <= 0)
+		return (silence);
+
+	// the DSP runs in double, and 64-bit samples are processed without conversion
+	if (gp.bypass) {
+		// bypass mode
+		for (int32 k = 0; k < channels; k++) {
+			if (in_silence & (uint64)1 << k)
+				for (int32 i = 0; i < len; i++)
+					out [k][i] = 0.0;
+			else {
+				for (int32 i = 0; i < len; i++)
+					out [k][i] = in [k][i];
+				silence &= ~((uint64)1 << k);
+			}
+		}
+		return (silence);
+	}
+
+	// a channel is flushed, if its input has been silent longer than the tail, and the DSP of flushed
+	// channels (of flushed lanes for Hilbert transformers) is skipped. Their states hold (nearly) zeros,
+	// and are cleared once when they get active again, not to keep stale history.
+	uint64 active = 0;					// channels not flushed
+	for (int32 k = 0; k < channels; k++) {
+		bool silent = in_silence & (uint64)1 << k;
+		if (! silent)
+			silent = std::all_of (in [k], in [k] + len, [] (SAMPLE x) {return (x == 0.0);});
+		if (! silent || silent_len [k] < tail_len)
+			active |= (uint64)1 << k;
+		silent_len [k] = silent ? std::min (silent_len [k] + len, SILENT_LEN_MAX) : 0;
+	}
+	silence &= ~active;
+	stale |= silence;
+	uint32 lanes_active = 0;			// transformers of LANES channels with an active channel
+	for (int32 p = 0; p < lanes / LANES; p++)
+		if (active >> p * LANES & (((uint64)1 << LANES) - 1))
+			lanes_active |= 1u << p;
+	stale_lanes |= ((1u << lanes / LANES) - 1) & ~lanes_active;
+	if (active == 0) {
+		mono = false;					// every chain restarts from zeros
+		gp.c_sb_switching = false;		// no switching noise in silence
+		for (int32 k = 0; k < channels; k++)
+			for (int32 i = 0; i < len; i++)
+				out [k][i] = 0.0;
+		return (silence);
+	}
+	if (stale & active)
+		stale_reset (stale & active, stale_lanes & lanes_active);
+
+	// mono mode is entered after identical channels for the tail, and left at once on divergence
+	if (MONO_PATH && channels > 1) {
+		bool identical = true;
+		for (int32 k = 1; k < channels && identical; k++)
+			identical = std::equal (in [0], in [0] + len, in [k]);
+		if (! identical) {
+			ident_len = 0;
+			if (mono)
+				mono_leave ();
+		} else {
+			if (! mono && ident_len >= tail_len)
+				mono_enter ();
+			ident_len = std::min (ident_len + len, SILENT_LEN_MAX);
+		}
+	}
+	const int32 ch = chains ();
+
+	const double wet_diff = (wet_end - gp.wet) / len;		// wet ramp per sample
+	double* yn [MAX_CHANNELS];			// input, filtered input, modulated signal
+	double* dry [MAX_CHANNELS];
+	double* zn [MAX_CHANNELS];
+	double* zHn [MAX_CHANNELS];
+	for (int32 k = 0; k < lanes; k++) {
+		yn [k] = yn_buf [k];
+		dry [k] = dry_buf [k];
+		zn [k] = zn_buf [k];
+		zHn [k] = zHn_buf [k];
+	}
+	// DSP mode: each stage processes a whole sub-block of all channels before the next one
+	for (int32 done = 0; done < len; done += PROC_BLOCK_LEN) {
+		const int32 blk_len = std::min (len - done, PROC_BLOCK_LEN);
+		double xn [PROC_BLOCK_LEN], xHn [PROC_BLOCK_LEN];		// carrier
+
+		for (int32 k = 0; k < ch; k++)
+			if (active >> k & 1)
+				for (int32 i = 0; i < blk_len; i++)
+					yn [k][i] = in [k][done + i];
+			else										// for the other lane of a transformer
+				for (int32 i = 0; i < blk_len; i++)
+					yn [k][i] = 0.0;
+		for (int32 k = channels; k < lanes; k++)				// unused lane of the last Hilbert transformer
+			for (int32 i = 0; i < blk_len; i++)
+				yn [k][i] = 0.0;
+
+		// carrier
+		carrier_process (yn, xn, xHn, blk_len);
+
+		// dry signal, input filters and Hilbert transformer
+		if (gp.ht_mode == (int32)HT_MODE_L::LOW_LATENCY) {
+			for (int32 k = 0; k < ch; k++)
+				if (active >> k & 1)
+					for (int32 i = 0; i < blk_len; i++)
+						dry [k][i] = yn [k][i];
+			I_IIR.process (yn, yn, blk_len, ch, active);
+			for (int32 k = 0; k < ch; k++)
+				if (active >> k & 1)
+					HT_IIR [k].process (yn [k], zn [k], zHn [k], blk_len);
+		} else {
+			for (int32 k = 0; k < ch; k++)
+				if (active >> k & 1)
+					DDL [k].delay (yn [k], dry [k], blk_len, DDL_LEN - 1 - fir_latency (gp.ht_quality));
+			if constexpr (MERGED_INPUT_HPF) {
+				I_LPF.process (yn, yn, blk_len, ch, active);
+				bp_process (yn, zn, zHn, blk_len, lanes_active);
+			} else {
+				for (int32 k = 0; k < ch; k++)
+					if (active >> k & 1)
+						I_HPF [k].process (yn [k], yn [k], blk_len);
+				I_LPF.process (yn, yn, blk_len, ch, active);
+				ht_process (yn, zn, zHn, blk_len, lanes_active);
+			}
+		}
+
+		// modulation
+		for (int32 i = 0; i < blk_len; i++) {
+			if (gp.c_sb_switching && std::abs (xHn [i]) < 0.01)	// side band switching noise reduction
+				gp.c_sb_switching = false;
+
+			// the sign of xHn selects the side band
+			bool lsb = (! gp.c_sb_switching && gp.c_freq < 0.0) || (gp.c_sb_switching && gp.c_freq >= 0.0);
+			if (! lsb)											// USB
+				xHn [i] = - xHn [i];
+		}
+		for (int32 k = 0; k < ch; k++)
+			if (active >> k & 1)
+				for (int32 i = 0; i < blk_len; i++)
+					yn [k][i] = zn [k][i] * xn [i] + zHn [k][i] * xHn [i];
+
+		// output filters
+		O_IIR.process (yn, yn, blk_len, ch, active);
+
+		// mix, channel 0 is duplicated in mono mode
+		for (int32 k = 0; k < channels; k++) {
+			SAMPLE* out_k = out [k] + done;
+			const double* yn_k = yn [mono ? 0 : k];
+			const double* dry_k = dry [mono ? 0 : k];
+			if (! (active >> k & 1))
+				for (int32 i = 0; i < blk_len; i++)
+					out_k [i] = 0.0;
+			else if (wet_diff == 0.0)
+				for (int32 i = 0; i < blk_len; i++)
+					out_k [i] = gp.wet * yn_k [i] + gp.dry * dry_k [i];
+			else
+				for (int32 i = 0; i < blk_len; i++) {
+					double wet_i = gp.wet + wet_diff * (done + i);
+					out_k [i] = wet_i * yn_k [i] + (1.0 - wet_i) * dry_k [i];
+				}
+		}
+	}
+	return (silence);
+}
+
+// the engine is instantiated for 32-bit and 64-bit samples
+template uint64 AQEngine:: process <float> (const float* const* in, float* const* out, const int32 len,
+	const uint64 in_silence, const double c_freq_end, const double wet_end);
+template uint64 AQEngine:: process <double> (const double* const* in, double* const* out, const int32 len,
+	const uint64 in_silence, const double c_freq_end, const double wet_end);
+
+void AQEngine:: apply_coefs (const Designer::coef_set& coefs)
+{
+	if (coefs.targets & Designer::I_HPF) {
+		for (auto& hpf: I_HPF)
+			hpf.set_coefs (coefs.i_hpf);
+		if constexpr (MERGED_INPUT_HPF) {
+			AQFIRfilters <double, I_HPF_IR_LEN, false>::impulse_response (coefs.i_hpf, i_hpf_ir);
+			bp_stale = (1 << (int)HT_QUALITY_L::LIST_LEN) - 1;
+			bp_set_coefs ();
+		}
+		I_IIR.set_coefs (0, coefs.i_mphpf [0]);
+		I_IIR.set_coefs (1, coefs.i_mphpf [1]);
+	}
+	if (coefs.targets & Designer::I_LPF) {
+		I_IIR.set_coefs (2, coefs.i_lpf);
+		I_LPF.set_coefs (0, coefs.i_lpf);
+	}
+	if (coefs.targets & Designer::O_HPF)
+		O_IIR.set_coefs (0, coefs.o_hpf);
+	if (coefs.targets & Designer::O_LPF)
+		O_IIR.set_coefs (1, coefs.o_lpf);
+	update_tail ();
+}
+
+void AQEngine:: carrier_setup (const double frequency)
+{
+	DDS.setup (sampling_rate, frequency);
+	FMDDS.setup (sampling_rate, frequency);
+	if (SINE_ROTATOR)
+		ROT.setup (sampling_rate, frequency);
+}
+
+void AQEngine:: carrier_ramp (const double frequency, const int32 len)
+{
+	DDS.ramp (frequency, len);
+	FMDDS.ramp (frequency, len);
+	if (SINE_ROTATOR)
+		ROT.ramp (frequency, len);
+}
+
+void AQEngine:: carrier_process (const double* const* yn, double* xn, double* xHn, const int32 len)
+{
+	if (carrier == CARRIER_L::FMDDS) {
+		double fm [PROC_BLOCK_LEN];				// frequency deviation
+		MOD.process (yn, chains (), fm, len);
+		FMDDS.process (gp.wform, fm, xn, xHn, len);
+	} else if (carrier == CARRIER_L::ROTATOR)
+		ROT.process (xn, xHn, len);
+	else
+		DDS.process (gp.wform, xn, xHn, len);
+}
+
+AQEngine::CARRIER_L AQEngine:: carrier_select () const
+{
+	if (gp.mod_src != (int32)MOD_SRC_L::OFF)
+		return (CARRIER_L::FMDDS);
+	else if (SINE_ROTATOR && gp.wform == (int32)WFORM_L::SINE)
+		return (CARRIER_L::ROTATOR);
+	else
+		return (CARRIER_L::DDS);
+}
+
+void AQEngine:: carrier_handover ()
+{
+	// each generator keeps its own phase, and the new one continues from the phase of the old one
+	double phase;
+	if (carrier == CARRIER_L::FMDDS)
+		phase = FMDDS.get_phase ();
+	else if (carrier == CARRIER_L::ROTATOR)
+		phase = ROT.get_phase ();
+	else
+		phase = DDS.get_phase ();
+
+	// the frequency of an idle generator is stale, since it has not followed ramps
+	carrier = carrier_select ();
+	const double frequency = std::abs (gp.c_freq);
+	if (carrier == CARRIER_L::FMDDS) {
+		FMDDS.setup (sampling_rate, frequency);
+		FMDDS.set_phase (phase);
+	} else if (carrier == CARRIER_L::ROTATOR) {
+		ROT.setup (sampling_rate, frequency);
+		ROT.set_phase (phase);
+	} else {
+		DDS.setup (sampling_rate, frequency);
+		DDS.set_phase (phase);
+	}
+}
+
+void AQEngine:: reset ()
+{
+	DDS.reset ();
+	ROT.reset ();
+	FMDDS.reset ();
+	MOD.reset ();
+	for (auto& ddl: DDL)
+		ddl.reset ();
+	ht_reset ();
+	for (auto& ht: HT_IIR)
+		ht.reset ();
+	for (auto& hpf: I_HPF)
+		hpf.reset ();
+	I_IIR.reset ();
+	I_LPF.reset ();
+	O_IIR.reset ();
+	if (realtime)
+		O_IIR.mute ((int32)(sampling_rate + 0.5) * O_MUTE_LEN / 1000);
+	for (int32 k = 0; k < MAX_CHANNELS; k++)
+		silent_len [k] = SILENT_LEN_MAX;		// all the states are zeros
+	stale = 0;
+	stale_lanes = 0;
+	mono = false;
+	ident_len = 0;
+	update_tail ();
+	gp.reset = true;
+}
+
+template <typename F>
+void AQEngine:: ht_dispatch (F&& f)
+{
+	// f (transformers of LANES channels, transformer of channel 0 in mono mode) of the current quality
+	switch (gp.ht_quality) {
+		case (int32)HT_QUALITY_L::DRAFT:
+			f (HT_DRAFT, HT_MONO_DRAFT);
+			break;
+		case (int32)HT_QUALITY_L::NORMAL:
+			f (HT_NORMAL, HT_MONO_NORMAL);
+			break;
+		case (int32)HT_QUALITY_L::HIGH:
+			f (HT_HIGH, HT_MONO_HIGH);
+			break;
+		default:
+			f (HT_EXACT, HT_MONO_EXACT);
+			break;
+	}
+}
+
+void AQEngine:: ht_process (const double* const* yn, double* const* zn, double* const* zHn, const int32 len, const uint32 lanes_active)
+{
+	ht_dispatch ([&] (auto& HT, auto& HT_MONO) {
+		if (mono)
+			HT_MONO.process (yn, zn, zHn, len);
+		else	// each transformer runs LANES channels
+			for (size_t p = 0; p < HT.size (); p++)
+				if (lanes_active >> p & 1)
+					HT [p].process (yn + p * LANES, zn + p * LANES, zHn + p * LANES, len);
+	});
+}
+
+void AQEngine:: stale_reset (const uint64 channels_reset, const uint32 lanes_reset)
+{
+	// states of channels (and transformers of LANES channels) skipped while flushed
+	for (int32 k = 0; k < channels; k++)
+		if (channels_reset >> k & 1) {
+			DDL [k].reset ();
+			I_HPF [k].reset ();
+			HT_IIR [k].reset ();
+			I_IIR.reset_channel (k);
+			I_LPF.reset_channel (k);
+			O_IIR.reset_channel (k);
+		}
+	auto reset = [lanes_reset] (auto& HT) {
+		for (size_t p = 0; p < HT.size (); p++)
+			if (lanes_reset >> p & 1)
+				HT [p].reset ();
+	};
+	reset (HT_DRAFT);
+	reset (HT_NORMAL);
+	reset (HT_HIGH);
+	reset (HT_EXACT);
+	reset (BP_DRAFT);
+	reset (BP_NORMAL);
+	reset (BP_HIGH);
+	reset (BP_EXACT);
+	stale &= ~channels_reset;
+	stale_lanes &= ~lanes_reset;
+}
+
+void AQEngine:: mono_enter ()
+{
+	// the other stages continue with channel 0
+	ht_dispatch ([] (auto& HT, auto& HT_MONO) {
+		HT_MONO.broadcast (HT [0], 0);
+	});
+	mono = true;
+}
+
+void AQEngine:: mono_leave ()
+{
+	// all channels take the state of channel 0, the input of which has been identical to theirs
+	for (int32 k = 1; k < channels; k++) {
+		DDL [k] = DDL [0];
+		I_HPF [k] = I_HPF [0];
+		HT_IIR [k] = HT_IIR [0];
+		I_IIR.copy_channel (k, 0);
+		I_LPF.copy_channel (k, 0);
+		O_IIR.copy_channel (k, 0);
+	}
+	ht_dispatch ([] (auto& HT, auto& HT_MONO) {
+		for (auto& ht: HT)
+			ht.broadcast (HT_MONO, 0);
+	});
+	mono = false;
+}
+
+void AQEngine:: ht_reset ()
+{
+	auto reset = [] (auto& HT) {
+		for (auto& ht: HT)
+			ht.reset ();
+	};
+	reset (HT_DRAFT);
+	reset (HT_NORMAL);
+	reset (HT_HIGH);
+	reset (HT_EXACT);
+	HT_MONO_DRAFT.reset ();
+	HT_MONO_NORMAL.reset ();
+	HT_MONO_HIGH.reset ();
+	HT_MONO_EXACT.reset ();
+	reset (BP_DRAFT);
+	reset (BP_NORMAL);
+	reset (BP_HIGH);
+	reset (BP_EXACT);
+}
+
+void AQEngine:: update_tail ()
+{
+	int64 tail = O_IIR.tail_samples (TAIL_DECAY);
+	if (gp.ht_mode == (int32)HT_MODE_L::LOW_LATENCY)
+		tail += (int64)I_IIR.tail_samples (TAIL_DECAY) + AQIIRHilbert <double>::tail_samples (TAIL_DECAY);
+	else
+		tail += ht_quality_len [gp.ht_quality] - 1 + I_HPF_IR_LEN - 1 + I_LPF.tail_samples (TAIL_DECAY);
+	tail_len = (int32)std::min <int64> (tail, SILENT_LEN_MAX);
+}
+
+void AQEngine:: bp_process (const double* const* yn, double* const* zn, double* const* zHn, const int32 len, const uint32 lanes_active)
+{
+	// each transformer runs LANES channels
+	auto process = [&] (auto& BP) {
+		for (size_t p = 0; p < BP.size (); p++)
+			if (lanes_active >> p & 1)
+				BP [p].process (yn + p * LANES, zn + p * LANES, zHn + p * LANES, len);
+	};
+	switch (gp.ht_quality) {
+		case (int32)HT_QUALITY_L::DRAFT:
+			process (BP_DRAFT);
+			break;
+		case (int32)HT_QUALITY_L::NORMAL:
+			process (BP_NORMAL);
+			break;
+		case (int32)HT_QUALITY_L::HIGH:
+			process (BP_HIGH);
+			break;
+		default:
+			process (BP_EXACT);
+			break;
+	}
+}
+
+void AQEngine:: bp_set_coefs ()
+{
+	// only the current quality is convolved, the others on demand
+	if (! (bp_stale & 1 << gp.ht_quality))
+		return;
+	auto set_coefs = [this] (auto& BP) {
+		for (auto& bp: BP)
+			bp.set_coefs (i_hpf_ir);
+	};
+	switch (gp.ht_quality) {
+		case (int32)HT_QUALITY_L::DRAFT:
+			set_coefs (BP_DRAFT);
+			break;
+		case (int32)HT_QUALITY_L::NORMAL:
+			set_coefs (BP_NORMAL);
+			break;
+		case (int32)HT_QUALITY_L::HIGH:
+			set_coefs (BP_HIGH);
+			break;
+		default:
+			set_coefs (BP_EXACT);
+			break;
+	}
+	bp_stale &= ~(1 << gp.ht_quality);
+}
+
+} // namespace suzumushi
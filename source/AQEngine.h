@@ -0,0 +1,209 @@
+//
+// Copyright (c) 2026 suzumushi
+//
+// 2026-10-17		AQEngine.h
+//
+// Licensed under Creative Commons Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0).
+//
+// https://creativecommons.org/licenses/by-nc-sa/4.0/
+//
+
+#pragma once
+
+#include <type_traits>
+#include <vector>
+
+// suzumushi:
+#include "AQparam.h"
+#include "AQDDS.h"
+#include "AQCompactDDS.h"
+#include "AQRotator.h"
+#include "AQFMDDS.h"
+#include "AQModulator.h"
+#include "AQHilbert.h"
+#include "AQFFTHilbert.h"
+#include "AQMCHilbert.h"
+#include "AQIIRHilbert.h"
+#include "AQBPHilbert.h"
+#include "AQFIRfilters.h"
+#include "SO2ndordIIRfilters.h"
+#include "SObiquads.h"
+#include "AQdesigner.h"
+
+
+namespace suzumushi {
+
+// AudioQAM DSP engine
+//
+// The whole process chain of AudioQAMProcessor without VST3 SDK types. Parameters are plain values
+// (not normalized) of AQparam.h, and audio is planar float or double. The engine is driven as follows:
+//	start ()						starts the background coefficient designer
+//	setup (), set_channels ()		sampling rate, offline or real-time and channels, outside of the audio thread
+//	activate ()						resets states and designs initial coefficients (and AQBLtables for a carrier
+//									other than sine) in the calling thread
+//	set_param (), update (), process ()	in the audio thread, update () before each process ()
+//	stop ()							stops the designer (also by the destructor)
+// Offline (realtime == false), coefficients are designed in the thread of update () exactly and
+// deterministically, and the output is not muted after reset. The designer thread is not required.
+
+class AQEngine {
+public:
+	static constexpr int32 MAX_CHANNELS = 16;		// up to 9.1.6
+
+	// parameters changed by update () (e.g. c_slide follows c_freq), reported back to the host
+	enum FEEDBACK {
+		FB_C_SLIDE = 1 << 0,
+		FB_C_FREQ = 1 << 1,
+		FB_I_H_FREQ = 1 << 2,
+		FB_I_L_FREQ = 1 << 3
+	};
+
+	void start ();
+	void stop ();
+	void setup (const double sampling_rate, const bool realtime = true);
+	void set_channels (const int32 ch);
+	void activate ();
+	void load (const GUI_param& param);				// all parameters at once, e.g. by setState ()
+	void set_param (const ParamID id, const ParamValue value);	// plain value, clamped to its range
+	int update ();									// returns FEEDBACK flags
+	// a block with linear ramps of c_freq and wet toward c_freq_end and wet_end. in_silence and the returned
+	// value are silence flags of input and output channels (bit k for channel k).
+	template <typename SAMPLE>						// float or double
+	uint64 process (const SAMPLE* const* in, SAMPLE* const* out, const int32 len, const uint64 in_silence,
+		const double c_freq_end, const double wet_end);
+	template <typename SAMPLE>
+	uint64 process (const SAMPLE* const* in, SAMPLE* const* out, const int32 len)
+	{
+		return (process (in, out, len, 0, gp.c_freq, gp.wet));
+	}
+	const GUI_param& params () const
+	{
+		return (gp);
+	}
+	int32 get_channels () const
+	{
+		return (channels);
+	}
+	int32 latency () const;							// samples
+	int32 tail () const								// samples
+	{
+		return (tail_len);
+	}
+
+private:
+	struct GUI_param gp;
+	double sampling_rate {44'100.0};
+	bool realtime {true};							// false for offline rendering
+
+	// DSP instances
+	static constexpr int32 LANES = 2;				// channels of a multichannel Hilbert transformer
+	int32 channels {2};								// channels of the bus arrangement
+	int32 lanes {2};								// channels rounded up to LANES
+	static constexpr int I_HPF_IR_LEN = 131;		// impulse response length of linear phase input HPF
+	static constexpr int DDL_LEN = (ht_quality_len [(int32)HT_QUALITY_L::EXACT] - 1) / 2 + (I_HPF_IR_LEN - 1) / 2 + 1;	// for the longest latency
+	static constexpr int fir_latency (const int32 quality)	// latency of linear phase mode
+	{
+		return ((ht_quality_len [quality] - 1) / 2 + (I_HPF_IR_LEN - 1) / 2);
+	}
+	static constexpr int32 PROC_BLOCK_LEN = 64;		// length of sub-blocks processed stage by stage
+	enum class HT_ENGINE_L {
+		DIRECT,										// AQHilbert
+		SIMD,										// AQMCHilbert (stereo lanes)
+		FFT											// AQFFTHilbert
+	};
+	static constexpr HT_ENGINE_L HT_ENGINE = HT_ENGINE_L::SIMD;	// implementation of Hilbert transformer
+	template <int IR_LEN, int CH = LANES>
+	using HTransformer = std::conditional_t <HT_ENGINE == HT_ENGINE_L::SIMD, AQMCHilbert <double, CH, IR_LEN>,
+		std::conditional_t <HT_ENGINE == HT_ENGINE_L::FFT, AQMCWrapper <AQFFTHilbert <double, IR_LEN>, double, CH>,
+		AQMCWrapper <AQHilbert <double, IR_LEN>, double, CH>>>;
+	enum class DDS_ENGINE_L {
+		TABLE,										// AQDDS (18,000 point quarter wave tables)
+		COMPACT										// AQCompactDDS (1,024 point interpolated tables)
+	};
+	static constexpr DDS_ENGINE_L DDS_ENGINE = DDS_ENGINE_L::TABLE;	// implementation of carrier
+	std::conditional_t <DDS_ENGINE == DDS_ENGINE_L::COMPACT, AQCompactDDS <double>, AQDDS <double>>	DDS;
+	static constexpr bool SINE_ROTATOR = true;		// sine carrier by AQRotator instead of DDS
+	AQRotator <double>								ROT;
+	AQFMDDS <double>								FMDDS;				// carrier with modulated frequency
+	AQModulator <double>							MOD;				// modulation source of carrier frequency
+	enum class CARRIER_L {
+		DDS,										// DDS
+		ROTATOR,									// ROT, sine carrier
+		FMDDS										// FMDDS, modulated carrier
+	};
+	CARRIER_L										carrier {CARRIER_L::DDS};	// generator of the carrier
+	// per-channel instances are allocated by set_channels (), and Hilbert transformers run LANES channels each
+	std::vector <SODDL <double, DDL_LEN>>			DDL;				// for each channel
+	std::vector <HTransformer <ht_quality_len [0]>>	HT_DRAFT;			// for each LANES channels, for each quality
+	std::vector <HTransformer <ht_quality_len [1]>>	HT_NORMAL;
+	std::vector <HTransformer <ht_quality_len [2]>>	HT_HIGH;
+	std::vector <HTransformer <ht_quality_len [3]>>	HT_EXACT;
+	HTransformer <ht_quality_len [0], 1>			HT_MONO_DRAFT;		// channel 0 in mono mode, for each quality
+	HTransformer <ht_quality_len [1], 1>			HT_MONO_NORMAL;
+	HTransformer <ht_quality_len [2], 1>			HT_MONO_HIGH;
+	HTransformer <ht_quality_len [3], 1>			HT_MONO_EXACT;
+	std::vector <AQIIRHilbert <double>>				HT_IIR;				// for each channel, low latency mode
+	static constexpr bool MERGED_INPUT_HPF = false;	// input HPF merged into Hilbert transformer (AQBPHilbert)
+	std::vector <AQBPHilbert <double, LANES, ht_quality_len [0], I_HPF_IR_LEN>>	BP_DRAFT;	// for each LANES channels, for each quality
+	std::vector <AQBPHilbert <double, LANES, ht_quality_len [1], I_HPF_IR_LEN>>	BP_NORMAL;
+	std::vector <AQBPHilbert <double, LANES, ht_quality_len [2], I_HPF_IR_LEN>>	BP_HIGH;
+	std::vector <AQBPHilbert <double, LANES, ht_quality_len [3], I_HPF_IR_LEN>>	BP_EXACT;
+	double											i_hpf_ir [I_HPF_IR_LEN] {};	// impulse response of input HPF for BP_*
+	int												bp_stale {0};		// BP_* (1 << quality) not yet convolved with i_hpf_ir
+	std::vector <AQFIRfilters <double, I_HPF_IR_LEN, false>>	I_HPF;	// for each channel
+	SObiquads <double, MAX_CHANNELS, 3>				I_IIR;				// minimum phase input HPF (2 sections) and input LPF, low latency mode
+	SObiquads <double, MAX_CHANNELS, 1>				I_LPF;				// input LPF, linear phase mode
+	SObiquads <double, MAX_CHANNELS, 2>				O_IIR;				// output HPF and LPF
+	alignas (64) double								yn_buf [MAX_CHANNELS][PROC_BLOCK_LEN];	// input, filtered input, modulated signal
+	alignas (64) double								dry_buf [MAX_CHANNELS][PROC_BLOCK_LEN];
+	alignas (64) double								zn_buf [MAX_CHANNELS][PROC_BLOCK_LEN];	// output of Hilbert transformer
+	alignas (64) double								zHn_buf [MAX_CHANNELS][PROC_BLOCK_LEN];
+	static constexpr int32 O_MUTE_LEN = 100;		// initial mute of output [ms]
+	using Designer = AQdesigner <AQFIRfilters <double, I_HPF_IR_LEN, false>, SOHPF <double, 0>,
+		SOLPF <double, i_l_freq.max>, SOHPF <double>, SOLPF <double, o_l_freq.max>>;
+	Designer										designer;			// background coefficient designer
+	int												design_targets {0};	// targets not yet requested
+	bool											bl_requested {false};	// AQBLtables::build () is requested
+	static constexpr bool PREWARM_COEF_CACHE = true;	// prewarm coefficient caches in setup ()
+
+	// silence
+	static constexpr double TAIL_DECAY = 1.0e-6;	// decay of IIR tails regarded as flushed (-120 dB)
+	static constexpr int32 SILENT_LEN_MAX = 1 << 30;
+	int32											tail_len {0};		// samples until the output flushes after the input gets silent
+	int32											silent_len [MAX_CHANNELS] {};	// consecutive silent input samples of each channel
+	uint64											stale {0};			// channels skipped while flushed (bit k for channel k)
+	uint32											stale_lanes {0};	// transformers of LANES channels skipped while flushed
+
+	// mono mode: all channels identical to channel 0 run the chain of channel 0 only
+	static constexpr bool MONO_PATH = ! MERGED_INPUT_HPF;	// (not implemented for AQBPHilbert)
+	bool											mono {false};		// in mono mode
+	int32											ident_len {0};		// consecutive samples of identical channels
+
+	// internal functions
+	void set_c_freq (const ParamValue update);
+	void carrier_setup (const double frequency);
+	void carrier_ramp (const double frequency, const int32 len);
+	void carrier_process (const double* const* yn, double* xn, double* xHn, const int32 len);
+	CARRIER_L carrier_select () const;				// generator for mod_src and wform
+	void carrier_handover ();
+	template <typename SAMPLE>
+	uint64 dsp_process (const SAMPLE* const* in, SAMPLE* const* out, const int32 len, const uint64 in_silence, const double wet_end);
+	void reset ();
+	void apply_coefs (const Designer::coef_set& coefs);
+	void ht_process (const double* const* yn, double* const* zn, double* const* zHn, const int32 len, const uint32 lanes_active);
+	void ht_reset ();
+	void stale_reset (const uint64 channels_reset, const uint32 lanes_reset);
+	void update_tail ();
+	int32 chains () const								// channels processed
+	{
+		return (mono ? 1 : channels);
+	}
+	void mono_enter ();
+	void mono_leave ();
+	template <typename F>
+	void ht_dispatch (F&& f);
+	void bp_process (const double* const* yn, double* const* zn, double* const* zHn, const int32 len, const uint32 lanes_active);
+	void bp_set_coefs ();
+};
+
+} // namespace suzumushi
@@ -1,7 +1,7 @@
 //
 // Copyright (c) 2023 suzumushi
 //
-// 2023-5-11		AQFIRfilters.h
+// 2026-10-17		AQFIRfilters.h
 //
 // Licensed under Creative Commons Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0).
 //
@@ -11,47 +11,71 @@
 #pragma once
 
 #include "SODDL.h"
-#ifdef _MSC_VER			// Visual C++
+#include "SOSIMD.h"
+#include <cmath>
 #include <numbers>
-using std::numbers::pi;
-#endif
 
 
 namespace suzumushi {
 
 // linear phase FIR LPF and HPF
+//
+// The symmetric impulse response is unfolded into UIR_TBL, zero padded at the oldest end to a multiple
+// of SO_SIMD_WIDTH, and yn is a dot product of UIR_TBL and the contiguous window of the mirrored input
+// delay line. Only the summation order differs from the folded form.
 
 template <typename TYPE, 
 	int IR_LEN = 67,							// Logical length of impulse response. IR_LEN must be an odd number.
 	bool LPF = true,							// set true for LPF and false for HPF
 	TYPE FC_MAX = 20'000.0,						// pass through frequency (LPF only)
-	int IR_CENTER = (IR_LEN - 1) / 2>			// Center of impulse response (don't touch this)
+	int IR_CENTER = (IR_LEN - 1) / 2,			// Center of impulse response (don't touch this)
+	int PAD_LEN = (IR_LEN + SO_SIMD_WIDTH - 1) / SO_SIMD_WIDTH * SO_SIMD_WIDTH>	// Padded length of impulse response (don't touch this)
 class AQFIRfilters {
 public:
+	struct coefs {								// coefficients, designed apart from the filter (e.g. in a background thread)
+		TYPE IR_TBL [IR_CENTER + 1];			// Impulse response table
+		bool pass_through;						// pass through mode
+	};
 	void setup (const TYPE SR, const TYPE fc);
+	static void design (coefs& c, const TYPE SR, const TYPE fc);
+	void set_coefs (const coefs& c);
+	static void impulse_response (const coefs& c, TYPE* ir);	// ir [IR_LEN], e.g. for AQBPHilbert
 	TYPE process (const TYPE xn);
+	void process (const TYPE* xn, TYPE* yn, const int len);		// xn and yn can be the same
 	void reset ();
 private:
-	TYPE IR_TBL [IR_CENTER + 1];				// Impulse response table
-	SODDL <TYPE, IR_LEN> IDL;					// Input delay line
+	static constexpr int PAD = PAD_LEN - IR_LEN;	// zero taps at the oldest end
+	alignas (64) TYPE UIR_TBL [PAD_LEN] {};		// Unfolded impulse response table
+	SOMDDL <TYPE, PAD_LEN> IDL;					// Input delay line
 	bool pass_through {false};					// pass through mode
 };
 
-template <typename TYPE, int IR_LEN, bool LPF, TYPE FC_MAX, int IR_CENTER>
+template <typename TYPE, int IR_LEN, bool LPF, TYPE FC_MAX, int IR_CENTER, int PAD_LEN>
 void
-AQFIRfilters <TYPE, IR_LEN, LPF, FC_MAX, IR_CENTER>:: 
+AQFIRfilters <TYPE, IR_LEN, LPF, FC_MAX, IR_CENTER, PAD_LEN>:: 
 setup (const TYPE SR, const TYPE fc)
+{
+	coefs c;
+	design (c, SR, fc);
+	set_coefs (c);
+}
+
+template <typename TYPE, int IR_LEN, bool LPF, TYPE FC_MAX, int IR_CENTER, int PAD_LEN>
+void
+AQFIRfilters <TYPE, IR_LEN, LPF, FC_MAX, IR_CENTER, PAD_LEN>:: 
+design (coefs& c, const TYPE SR, const TYPE fc)
 {	
+	TYPE* IR_TBL = c.IR_TBL;
 	if (fc < FC_MAX || !LPF) {
 		// sinc function 
 		IR_TBL [IR_CENTER] = 2.0 * fc / SR;
-		TYPE omega_cT = IR_TBL [IR_CENTER] * pi;
+		TYPE omega_cT = IR_TBL [IR_CENTER] * std::numbers::pi;
 		for (int i = 0, j = -IR_CENTER; i < IR_CENTER; i++, j++)
-			IR_TBL [i] = sin (j * omega_cT) / (j * pi);
+			IR_TBL [i] = std::sin (j * omega_cT) / (j * std::numbers::pi);
 
 		// hamming window
 		for (int i = 0; i <= IR_CENTER; i++)
-			IR_TBL [i]  *= 0.54 - 0.46 * cos (pi * i / IR_CENTER);
+			IR_TBL [i]  *= 0.54 - 0.46 * std::cos (std::numbers::pi * i / IR_CENTER);
 
 		// normalization
 		TYPE sum = 0.0;
@@ -64,33 +88,67 @@ setup (const TYPE SR, const TYPE fc)
 		if (!LPF)	// HPF
 			IR_TBL [IR_CENTER] = 1.0 - IR_TBL [IR_CENTER];
 
-		pass_through = false;
+		c.pass_through = false;
 	} else
-		pass_through = true;
+		c.pass_through = true;
+}
+
+template <typename TYPE, int IR_LEN, bool LPF, TYPE FC_MAX, int IR_CENTER, int PAD_LEN>
+void
+AQFIRfilters <TYPE, IR_LEN, LPF, FC_MAX, IR_CENTER, PAD_LEN>:: 
+set_coefs (const coefs& c)
+{
+	if (! c.pass_through) {
+		for (int i = 0, j = IR_LEN - 1; i < IR_CENTER; i++, j--)
+			UIR_TBL [PAD + i] = UIR_TBL [PAD + j] = LPF ? c.IR_TBL [i] : - c.IR_TBL [i];
+		UIR_TBL [PAD + IR_CENTER] = c.IR_TBL [IR_CENTER];
+	}
+	pass_through = c.pass_through;
+}
+
+template <typename TYPE, int IR_LEN, bool LPF, TYPE FC_MAX, int IR_CENTER, int PAD_LEN>
+void
+AQFIRfilters <TYPE, IR_LEN, LPF, FC_MAX, IR_CENTER, PAD_LEN>:: 
+impulse_response (const coefs& c, TYPE* ir)
+{
+	for (int i = 0; i < IR_LEN; i++)
+		ir [i] = 0.0;
+	if (c.pass_through)
+		ir [IR_CENTER] = 1.0;
+	else {
+		for (int i = 0, j = IR_LEN - 1; i < IR_CENTER; i++, j--)
+			ir [i] = ir [j] = LPF ? c.IR_TBL [i] : - c.IR_TBL [i];
+		ir [IR_CENTER] = c.IR_TBL [IR_CENTER];
+	}
 }
 
-template <typename TYPE, int IR_LEN, bool LPF, TYPE FC_MAX, int IR_CENTER>
+template <typename TYPE, int IR_LEN, bool LPF, TYPE FC_MAX, int IR_CENTER, int PAD_LEN>
 TYPE
-AQFIRfilters <TYPE, IR_LEN, LPF, FC_MAX, IR_CENTER>:: 
+AQFIRfilters <TYPE, IR_LEN, LPF, FC_MAX, IR_CENTER, PAD_LEN>:: 
 process (const TYPE xn)
 {
 	IDL.enqueue (xn);
 	if (pass_through)
-		return (IDL.read (IR_CENTER));
-	else {
-		TYPE yn = 0.0;
-		for (int i = 0, j = IR_LEN - 1; i < IR_CENTER; i++, j--)
-			yn += IR_TBL [i] * (IDL.read (i) + IDL.read (j));
-		if (LPF)
-			return (yn + IR_TBL [IR_CENTER] * IDL.read (IR_CENTER));
-		else // HPF
-			return (-yn + IR_TBL [IR_CENTER] * IDL.read (IR_CENTER));
-	}
+		return (IDL.read (PAD + IR_CENTER));
+	else
+		return (SOdot <TYPE, PAD_LEN> (UIR_TBL, IDL.window ().data ()));
+}
+
+template <typename TYPE, int IR_LEN, bool LPF, TYPE FC_MAX, int IR_CENTER, int PAD_LEN>
+void
+AQFIRfilters <TYPE, IR_LEN, LPF, FC_MAX, IR_CENTER, PAD_LEN>:: 
+process (const TYPE* xn, TYPE* yn, const int len)
+{
+	if (pass_through)
+		IDL.delay (xn, yn, len, PAD + IR_CENTER);
+	else
+		for (int i = 0; i < len; i++)
+			yn [i] = process (xn [i]);
 }
 
-template <typename TYPE, int IR_LEN, bool LPF, TYPE FC_MAX, int IR_CENTER>
+template <typename TYPE, int IR_LEN, bool LPF, TYPE FC_MAX, int IR_CENTER, int PAD_LEN>
 void
-AQFIRfilters <TYPE, IR_LEN, LPF, FC_MAX, IR_CENTER>:: 
+AQFIRfilters <TYPE, IR_LEN, LPF, FC_MAX, IR_CENTER, PAD_LEN>:: 
 reset ()
 {
 	IDL.reset ();
@@ -0,0 +1,147 @@
+//
+// Copyright (c) 2026 suzumushi
+//
+// 2026-10-17		AQFMDDS.h
+//
+// Licensed under Creative Commons Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0).
+//
+// https://creativecommons.org/licenses/by-nc-sa/4.0/
+//
+
+#pragma once
+
+#include <cstdint>
+#include "AQDDS.h"
+
+
+namespace suzumushi {
+
+// Direct Digital Synthesizer with pi/2 phase lag output for audio-rate frequency modulation
+//
+// The phase is a 32.32 fixed point position in the wave tables of AQDDS, and the increment is
+// calculated from the frequency of each sample with one multiplication. Unlike AQDDS, no division and
+// no re-initialization of phase errors are needed when the frequency changes. The frequency of each
+// sample is the base frequency of setup () and ramp () plus the deviation fm [i], clamped to [0, SR/2].
+// The output is not bit-identical to AQDDS at a constant frequency: the 32.32 increment is rounded, while
+// AQDDS steps by N / SR exactly with a Bresenham remainder, so table indices differ by one at some samples.
+
+template <typename TYPE, 
+	int WT_LEN = 18'000>						// Logical length of a wave table (same as AQDDS)
+class AQFMDDS {
+public:
+	void setup (const double samplingRate, const TYPE frequency);
+	void process (const int waveform, const TYPE* fm, TYPE* yn, TYPE* yHn, const int len);
+	template <WFORM_L WAVEFORM>
+	void generate (const TYPE* fm, TYPE* yn, TYPE* yHn, const int len);
+	void ramp (const TYPE frequency, const int len);	// linear ramp to frequency in the next len samples
+	void reset ();
+	double get_phase () const;					// in cycles [0, 1), to hand the carrier over to another generator
+	void set_phase (const double cycles);		// after setup ()
+private:
+	static constexpr uint64_t CYCLE = (uint64_t)WT_LEN << 32;	// WT_LEN in 32.32 fixed point
+	uint64_t phase {0};							// phase in 32.32 fixed point
+	double SR {0.0};							// sampling rate
+	TYPE scale {0.0};							// increment per Hz, WT_LEN * 2^32 / SR
+	TYPE f_max {0.0};							// SR / 2
+	TYPE f {0.0};								// base frequency
+	TYPE f_end {0.0};							// base frequency at the end of ramp
+	TYPE f_diff {0.0};							// base frequency difference per sample
+	int ramp_len {0};							// remaining samples of ramp
+};
+
+template <typename TYPE, int WT_LEN>
+void
+AQFMDDS <TYPE, WT_LEN>:: 
+setup (const double samplingRate, const TYPE frequency)
+{
+	if (samplingRate != SR) {
+		SR = samplingRate;
+		scale = WT_LEN * 4'294'967'296.0 / SR;
+		f_max = SR / 2.0;
+		phase = 0;
+	}
+	f = frequency;
+	ramp_len = 0;
+}
+
+template <typename TYPE, int WT_LEN>
+void
+AQFMDDS <TYPE, WT_LEN>:: 
+ramp (const TYPE frequency, const int len)
+{
+	if (SR == 0.0 || len <= 0)
+		return;
+	f_end = frequency;
+	f_diff = (f_end - f) / len;
+	ramp_len = len;
+}
+
+template <typename TYPE, int WT_LEN>
+void
+AQFMDDS <TYPE, WT_LEN>:: 
+process (const int waveform, const TYPE* fm, TYPE* yn, TYPE* yHn, const int len)
+{
+	switch (waveform) {
+		case (int)WFORM_L::SINE:
+			generate <WFORM_L::SINE> (fm, yn, yHn, len);
+			break;
+		case (int)WFORM_L::TRIANGLE:
+			generate <WFORM_L::TRIANGLE> (fm, yn, yHn, len);
+			break;
+		case (int)WFORM_L::SQUARE:
+			generate <WFORM_L::SQUARE> (fm, yn, yHn, len);
+			break;
+		case (int)WFORM_L::SAWTOOTH:
+			generate <WFORM_L::SAWTOOTH> (fm, yn, yHn, len);
+			break;
+		default:
+			generate <WFORM_L::LIST_LEN> (fm, yn, yHn, len);
+			break;
+	}
+}
+
+template <typename TYPE, int WT_LEN>
+template <WFORM_L WAVEFORM>
+void
+AQFMDDS <TYPE, WT_LEN>:: 
+generate (const TYPE* fm, TYPE* yn, TYPE* yHn, const int len)
+{
+	uint64_t p = phase;
+	for (int i = 0; i < len; i++) {
+		AQDDS <TYPE, WT_LEN>::template lookup <WAVEFORM> ((int)(p >> 32), yn [i], yHn [i]);
+		TYPE fi = f + fm [i];
+		fi = fi < 0.0 ? 0.0 : (fi > f_max ? f_max : fi);
+		p += (uint64_t)(fi * scale + 0.5);
+		p -= p >= CYCLE ? CYCLE : 0;
+		if (ramp_len > 0)
+			f = --ramp_len == 0 ? f_end : f + f_diff;
+	}
+	phase = p;
+}
+
+template <typename TYPE, int WT_LEN>
+double
+AQFMDDS <TYPE, WT_LEN>:: 
+get_phase () const
+{
+	return ((double)phase / CYCLE);
+}
+
+template <typename TYPE, int WT_LEN>
+void
+AQFMDDS <TYPE, WT_LEN>:: 
+set_phase (const double cycles)
+{
+	phase = (uint64_t)(cycles * CYCLE + 0.5);
+	phase -= phase >= CYCLE ? CYCLE : 0;
+}
+
+template <typename TYPE, int WT_LEN>
+void
+AQFMDDS <TYPE, WT_LEN>:: 
+reset ()
+{
+	SR = 0.0;
+}
+
+} // namespace suzumushi
@@ -1,7 +1,7 @@
 //
 // Copyright (c) 2023 suzumushi
 //
-// 2023-4-6		AQHilbert.h
+// 2026-10-16		AQHilbert.h
 //
 // Licensed under Creative Commons Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0).
 //
@@ -10,15 +10,45 @@
 
 #pragma once
 
+#include <array>
 #include "SODDL.h"
-#ifdef _MSC_VER			// Visual C++
-#include <numbers>
-using std::numbers::pi;
-#endif
+#include "SOconstexprmath.h"
 
 
 namespace suzumushi {
 
+// Impulse response of Hilbert transformer (Blackman window), generated at compile time.
+// Only non-zero taps of the first half are stored: IR_TBL [i / 2] is the coefficient of
+// x [n - i] for even i < IR_CENTER, and the coefficient of x [n - (IR_LEN - 1 - i)] is - IR_TBL [i / 2].
+
+template <typename TYPE, int IR_LEN, int IR_CENTER = (IR_LEN - 1) / 2, int IR_TBL_LEN = (IR_LEN + 1) / 4>
+constexpr std::array <TYPE, IR_TBL_LEN> AQHilbert_IR_TBL ()
+{
+	std::array <TYPE, IR_TBL_LEN> IR_TBL {};
+	for (int i = 0; i < IR_CENTER; i += 2) {
+		double h = 2.0 / (std::numbers::pi * (i - IR_CENTER));
+		// Blackman window
+		h *= 0.42 - 0.5 * cx::cos (std::numbers::pi * i / IR_CENTER) + 0.08 * cx::cos (2.0 * std::numbers::pi * i / IR_CENTER);
+		IR_TBL [i / 2] = h;
+	}
+	return (IR_TBL);
+}
+
+// Unfolded impulse response for polyphase histories: the coefficient of x [n - 2m] for m < HIST_LEN.
+// Coefficients for m > IR_CENTER are 0.0 (padding).
+
+template <typename TYPE, int IR_LEN, int HIST_LEN, int IR_CENTER = (IR_LEN - 1) / 2>
+constexpr std::array <TYPE, HIST_LEN> AQHilbert_unfolded_IR_TBL ()
+{
+	constexpr std::array <TYPE, (IR_LEN + 1) / 4> IR_TBL = AQHilbert_IR_TBL <TYPE, IR_LEN> ();
+	std::array <TYPE, HIST_LEN> UIR_TBL {};
+	for (int i = 0; i < IR_CENTER; i += 2) {
+		UIR_TBL [i / 2] = IR_TBL [i / 2];
+		UIR_TBL [IR_CENTER - i / 2] = - IR_TBL [i / 2];
+	}
+	return (UIR_TBL);
+}
+
 // FIR filter-based Hilbert transformer
 
 template <typename TYPE, 
@@ -27,42 +57,34 @@ template <typename TYPE,
 	int IR_TBL_LEN = (IR_LEN + 1) / 4>			// Length of impulse response table (don't touch this)
 class AQHilbert {
 public:
-	AQHilbert ();
 	void process (const TYPE xn, TYPE &yn, TYPE &yHn);
+	void process (const TYPE* xn, TYPE* yn, TYPE* yHn, const int len);
 	void reset ();
 private:
-	static TYPE IR_TBL [IR_TBL_LEN];			// Impulse response table
-	SODDL <TYPE, IR_LEN> IDL;					// Input delay line
+	static constexpr std::array <TYPE, IR_TBL_LEN> IR_TBL = AQHilbert_IR_TBL <TYPE, IR_LEN> ();	// Impulse response table
+	SOMDDL <TYPE, IR_LEN> IDL;					// Input delay line
 };
 
-template <typename TYPE, int IR_LEN, int IR_CENTER, int IR_TBL_LEN>
-TYPE
-AQHilbert <TYPE, IR_LEN, IR_CENTER, IR_TBL_LEN>:: 
-IR_TBL [IR_TBL_LEN];
-
-template <typename TYPE, int IR_LEN, int IR_CENTER, int IR_TBL_LEN>
-AQHilbert <TYPE, IR_LEN, IR_CENTER, IR_TBL_LEN>:: 
-AQHilbert ()
-{	
-	if (IR_TBL [IR_TBL_LEN - 1] == 0.0) {
-		for (int i = 0; i < IR_CENTER; i += 2)
-			IR_TBL [i / 2] = 2.0 / (pi * (i - IR_CENTER));
-		// Blackman window
-		for (int i = 0; i < IR_CENTER; i += 2)
-			IR_TBL [i / 2] *= 0.42 - 0.5 * cos (pi * i / IR_CENTER) + 0.08 * cos (2.0 * pi * i / IR_CENTER);
-	}
-}
-
 template <typename TYPE, int IR_LEN, int IR_CENTER, int IR_TBL_LEN>
 void
 AQHilbert <TYPE, IR_LEN, IR_CENTER, IR_TBL_LEN>:: 
 process (const TYPE xn, TYPE &yn, TYPE &yHn)
 {
 	IDL.enqueue (xn);
-	yn = IDL.read (IR_CENTER);
+	const TYPE* x = IDL.window ().data ();
+	yn = x [IR_CENTER];
 	yHn = 0.0;
 	for (int i = 0, j = IR_LEN - 1; i < IR_CENTER; i += 2, j -= 2)
-		yHn += IR_TBL [i / 2] * (IDL.read (j) - IDL.read (i));
+		yHn += IR_TBL [i / 2] * (x [j] - x [i]);
+}
+
+template <typename TYPE, int IR_LEN, int IR_CENTER, int IR_TBL_LEN>
+void
+AQHilbert <TYPE, IR_LEN, IR_CENTER, IR_TBL_LEN>:: 
+process (const TYPE* xn, TYPE* yn, TYPE* yHn, const int len)
+{
+	for (int i = 0; i < len; i++)
+		process (xn [i], yn [i], yHn [i]);
 }
 
 template <typename TYPE, int IR_LEN, int IR_CENTER, int IR_TBL_LEN>
@@ -0,0 +1,115 @@
+//
+// Copyright (c) 2026 suzumushi
+//
+// 2026-10-16		AQIIRHilbert.h
+//
+// Licensed under Creative Commons Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0).
+//
+// https://creativecommons.org/licenses/by-nc-sa/4.0/
+//
+
+#pragma once
+
+#include <cmath>
+#include <algorithm>
+
+namespace suzumushi {
+
+// IIR allpass-pair Hilbert transformer (low latency)
+//
+// Two cascades of four polyphase allpass sections, H (z) = (a^2 - z^-2) / (1 - a^2 z^-2), whose phase
+// responses differ by 90 degrees (within +/-1 degree from 0.0005 * fs to 0.48 * fs). The first path
+// is delayed by one sample to produce yn, and the second one produces yHn lagging yn by pi/2.
+// There is no pure delay. The group delay is about 14 samples at 1 kHz and 126 samples at 100 Hz (48 kHz).
+// Coefficients by Olli Niemitalo.
+// The slowest pole (|z| = 0.9987) takes about 11,000 samples to decay by 120 dB, independent of fs.
+
+template <typename TYPE>
+class AQIIRHilbert {
+public:
+	void process (const TYPE xn, TYPE &yn, TYPE &yHn);
+	void process (const TYPE* xn, TYPE* yn, TYPE* yHn, const int len);
+	void reset ();
+	static int tail_samples (const TYPE decay);	// samples until the impulse response decays below decay
+private:
+	static constexpr int SECTIONS = 4;
+	static constexpr TYPE A_TBL [SECTIONS] = {		// a^2 of in-phase path
+		0.6923878 * 0.6923878,
+		0.9360654322959 * 0.9360654322959,
+		0.9882295226860 * 0.9882295226860,
+		0.9987488452737 * 0.9987488452737
+	};
+	static constexpr TYPE B_TBL [SECTIONS] = {		// a^2 of quadrature path
+		0.4021921162426 * 0.4021921162426,
+		0.8561710882420 * 0.8561710882420,
+		0.9722909545651 * 0.9722909545651,
+		0.9952884791278 * 0.9952884791278
+	};
+	TYPE az [SECTIONS + 1][2] {};				// delay registers of in-phase path (input and output of each section)
+	TYPE bz [SECTIONS + 1][2] {};				// delay registers of quadrature path
+	TYPE delay {0.0};							// one sample delay of in-phase path
+};
+
+template <typename TYPE>
+void
+AQIIRHilbert <TYPE>::
+process (const TYPE xn, TYPE &yn, TYPE &yHn)
+{
+	// az [i][0] and az [i][1] hold x [n - 1] and x [n - 2] of section i (output of section i - 1)
+	TYPE a = xn;
+	TYPE b = xn;
+	for (int i = 0; i < SECTIONS; i++) {
+		TYPE ay = A_TBL [i] * (a + az [i + 1][1]) - az [i][1];
+		az [i][1] = az [i][0];
+		az [i][0] = a;
+		a = ay;
+		TYPE by = B_TBL [i] * (b + bz [i + 1][1]) - bz [i][1];
+		bz [i][1] = bz [i][0];
+		bz [i][0] = b;
+		b = by;
+	}
+	az [SECTIONS][1] = az [SECTIONS][0];
+	az [SECTIONS][0] = a;
+	bz [SECTIONS][1] = bz [SECTIONS][0];
+	bz [SECTIONS][0] = b;
+
+	yn = delay;
+	delay = a;
+	yHn = -b;
+}
+
+template <typename TYPE>
+void
+AQIIRHilbert <TYPE>::
+process (const TYPE* xn, TYPE* yn, TYPE* yHn, const int len)
+{
+	for (int i = 0; i < len; i++)
+		process (xn [i], yn [i], yHn [i]);
+}
+
+template <typename TYPE>
+void
+AQIIRHilbert <TYPE>::
+reset ()
+{
+	for (int i = 0; i <= SECTIONS; i++)
+		az [i][0] = az [i][1] = bz [i][0] = bz [i][1] = 0.0;
+	delay = 0.0;
+}
+
+template <typename TYPE>
+int
+AQIIRHilbert <TYPE>::
+tail_samples (const TYPE decay)
+{
+	// poles of each section are z = +/-a, and the tails of cascaded sections are summed
+	TYPE a_tail = 1.0;
+	TYPE b_tail = 0.0;
+	for (int i = 0; i < SECTIONS; i++) {
+		a_tail += 2.0 + 2.0 * std::log (decay) / std::log (A_TBL [i]);
+		b_tail += 2.0 + 2.0 * std::log (decay) / std::log (B_TBL [i]);
+	}
+	return ((int)std::ceil (std::max (a_tail, b_tail)));
+}
+
+} // namespace suzumushi
@@ -0,0 +1,139 @@
+//
+// Copyright (c) 2026 suzumushi
+//
+// 2026-10-16		AQMCHilbert.h
+//
+// Licensed under Creative Commons Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0).
+//
+// https://creativecommons.org/licenses/by-nc-sa/4.0/
+//
+
+#pragma once
+
+#include "AQHilbert.h"
+#include "SOSIMD.h"
+
+
+namespace suzumushi {
+
+// Multichannel SIMD direct form Hilbert transformer
+//
+// Same algorithm as AQSIMDHilbert, but the polyphase histories of CH channels are stored interleaved,
+// so that one coefficient load feeds all channels in SIMD lanes (SOdot_interleaved ()).
+// Output is identical to CH instances of AQSIMDHilbert within the tolerance documented there.
+// broadcast () sets every channel to the state of one channel of another instance of any CH, e.g. to
+// switch between a stereo pair and a mono instance fed with identical signals.
+
+template <typename TYPE,
+	int CH = 2,									// number of channels
+	int IR_LEN = 259,							// Logical length of impulse response. (IR_LEN - 1) / 2 must be an odd number.
+	int IR_CENTER = (IR_LEN - 1) / 2,			// Center of impulse response (don't touch this)
+	int HIST_LEN = (IR_CENTER + 1 + SO_SIMD_WIDTH - 1) / SO_SIMD_WIDTH * SO_SIMD_WIDTH>	// Length of a polyphase history (don't touch this)
+class AQMCHilbert {
+public:
+	void process (const TYPE* xn, TYPE* yn, TYPE* yHn);		// xn [CH], yn [CH], yHn [CH]
+	void process (const TYPE* const* xn, TYPE* const* yn, TYPE* const* yHn, const int len);	// xn [CH][len], ...
+	void reset ();
+	template <int SRC_CH>
+	void broadcast (const AQMCHilbert <TYPE, SRC_CH, IR_LEN, IR_CENTER, HIST_LEN>& src, const int src_k);
+private:
+	template <typename, int, int, int, int> friend class AQMCHilbert;
+	alignas (64) static constexpr std::array <TYPE, HIST_LEN> IR_TBL = AQHilbert_unfolded_IR_TBL <TYPE, IR_LEN, HIST_LEN> ();
+	alignas (64) TYPE MDL [2][2 * HIST_LEN * CH] {};	// Interleaved mirrored delay lines of even and odd samples
+	int head {0};									// head of MDL (the latest sample)
+	int parity {0};									// parity of the latest sample
+};
+
+template <typename TYPE, int CH, int IR_LEN, int IR_CENTER, int HIST_LEN>
+void
+AQMCHilbert <TYPE, CH, IR_LEN, IR_CENTER, HIST_LEN>::
+process (const TYPE* xn, TYPE* yn, TYPE* yHn)
+{
+	parity ^= 1;
+	if (parity == 0 && --head < 0)
+		head = HIST_LEN - 1;
+	TYPE* latest = MDL [parity] + head * CH;
+	for (int k = 0; k < CH; k++)
+		latest [k] = latest [k + HIST_LEN * CH] = xn [k];
+
+	const TYPE* other = MDL [parity ^ 1] + (parity == 0 ? head + 1 : head) * CH + (IR_CENTER - 1) / 2 * CH;
+	for (int k = 0; k < CH; k++)
+		yn [k] = other [k];
+	SOdot_interleaved <TYPE, HIST_LEN, CH> (IR_TBL.data (), latest, yHn);
+}
+
+template <typename TYPE, int CH, int IR_LEN, int IR_CENTER, int HIST_LEN>
+void
+AQMCHilbert <TYPE, CH, IR_LEN, IR_CENTER, HIST_LEN>::
+process (const TYPE* const* xn, TYPE* const* yn, TYPE* const* yHn, const int len)
+{
+	// planar blocks are interleaved per sample, as the histories are interleaved
+	for (int i = 0; i < len; i++) {
+		TYPE x [CH], y [CH], yH [CH];
+		for (int k = 0; k < CH; k++)
+			x [k] = xn [k][i];
+		process (x, y, yH);
+		for (int k = 0; k < CH; k++) {
+			yn [k][i] = y [k];
+			yHn [k][i] = yH [k];
+		}
+	}
+}
+
+template <typename TYPE, int CH, int IR_LEN, int IR_CENTER, int HIST_LEN>
+void
+AQMCHilbert <TYPE, CH, IR_LEN, IR_CENTER, HIST_LEN>::
+reset ()
+{
+	for (int i = 0; i < 2 * HIST_LEN * CH; i++)
+		MDL [0][i] = MDL [1][i] = 0.0;
+	head = parity = 0;
+}
+
+template <typename TYPE, int CH, int IR_LEN, int IR_CENTER, int HIST_LEN>
+template <int SRC_CH>
+void
+AQMCHilbert <TYPE, CH, IR_LEN, IR_CENTER, HIST_LEN>::
+broadcast (const AQMCHilbert <TYPE, SRC_CH, IR_LEN, IR_CENTER, HIST_LEN>& src, const int src_k)
+{
+	for (int d = 0; d < 2; d++)
+		for (int i = 0; i < 2 * HIST_LEN; i++)
+			for (int k = 0; k < CH; k++)
+				MDL [d][i * CH + k] = src.MDL [d][i * SRC_CH + src_k];
+	head = src.head;
+	parity = src.parity;
+}
+
+// CH instances of a single channel Hilbert transformer with the interface of AQMCHilbert
+
+template <typename HT, typename TYPE, int CH = 2>
+class AQMCWrapper {
+public:
+	void process (const TYPE* xn, TYPE* yn, TYPE* yHn)
+	{
+		for (int k = 0; k < CH; k++)
+			HTs [k].process (xn [k], yn [k], yHn [k]);
+	}
+	void process (const TYPE* const* xn, TYPE* const* yn, TYPE* const* yHn, const int len)
+	{
+		// each channel is processed through the whole block
+		for (int k = 0; k < CH; k++)
+			HTs [k].process (xn [k], yn [k], yHn [k], len);
+	}
+	void reset ()
+	{
+		for (int k = 0; k < CH; k++)
+			HTs [k].reset ();
+	}
+	template <int SRC_CH>
+	void broadcast (const AQMCWrapper <HT, TYPE, SRC_CH>& src, const int src_k)
+	{
+		for (int k = 0; k < CH; k++)
+			HTs [k] = src.HTs [src_k];
+	}
+private:
+	template <typename, typename, int> friend class AQMCWrapper;
+	HT HTs [CH];
+};
+
+} // namespace suzumushi
@@ -0,0 +1,143 @@
+//
+// Copyright (c) 2026 suzumushi
+//
+// 2026-10-17		AQModulator.h
+//
+// Licensed under Creative Commons Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0).
+//
+// https://creativecommons.org/licenses/by-nc-sa/4.0/
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include "AQparam.h"
+#include "SOconstexprmath.h"
+
+
+namespace suzumushi {
+
+// Modulation source of carrier wave frequency
+//
+// process () outputs the frequency deviation fm [i] = depth * m [i] for AQFMDDS, where m [i] is
+//	LFO:		a waveform of MOD_SHAPE_L in [-1, 1] at rate [Hz] (32 bit phase accumulator)
+//	ENVELOPE:	max |xn [k]| of ch channels smoothed by a one-pole LPF with cutoff frequency rate [Hz]
+//	OFF:		0
+
+template <typename TYPE,
+	int TBL_BITS = 10>							// log2 of sine table length of LFO
+class AQModulator {
+public:
+	void setup (const double samplingRate, const int source, const int shape, const TYPE rate, const TYPE depth);
+	void process (const TYPE* const* xn, const int ch, TYPE* fm, const int len);		// xn [ch][len]
+	void reset ();
+private:
+	static constexpr int TBL_LEN = 1 << TBL_BITS;
+	static constexpr int FRAC_BITS = 32 - TBL_BITS;
+	static constexpr std::array <TYPE, TBL_LEN + 1> SIN_TBL = [] {
+		std::array <TYPE, TBL_LEN + 1> TBL {};
+		for (int i = 0; i <= TBL_LEN; i++)
+			TBL [i] = cx::sin (2.0 * std::numbers::pi * i / TBL_LEN);
+		return (TBL);
+	} ();
+	template <MOD_SHAPE_L SHAPE>
+	void lfo (TYPE* fm, const int len);
+	int source {(int)MOD_SRC_L::OFF};
+	int shape {(int)MOD_SHAPE_L::SINE};
+	TYPE depth {0.0};
+	uint32_t phase {0};							// LFO phase in 2^-32 cycle
+	uint32_t phase_inc {0};						// LFO phase increment per sample
+	TYPE k {0.0};								// envelope follower coefficient
+	TYPE env {0.0};								// envelope
+};
+
+template <typename TYPE, int TBL_BITS>
+void
+AQModulator <TYPE, TBL_BITS>:: 
+setup (const double samplingRate, const int source, const int shape, const TYPE rate, const TYPE depth)
+{
+	this->source = source;
+	this->shape = shape;
+	this->depth = depth;
+	phase_inc = (uint32_t)(rate / samplingRate * 4'294'967'296.0);
+	k = 1.0 - std::exp (-2.0 * std::numbers::pi * rate / samplingRate);
+}
+
+template <typename TYPE, int TBL_BITS>
+void
+AQModulator <TYPE, TBL_BITS>:: 
+process (const TYPE* const* xn, const int ch, TYPE* fm, const int len)
+{
+	if (source == (int)MOD_SRC_L::LFO) {
+		switch (shape) {
+			case (int)MOD_SHAPE_L::SINE:
+				lfo <MOD_SHAPE_L::SINE> (fm, len);
+				break;
+			case (int)MOD_SHAPE_L::TRIANGLE:
+				lfo <MOD_SHAPE_L::TRIANGLE> (fm, len);
+				break;
+			case (int)MOD_SHAPE_L::SAW_UP:
+				lfo <MOD_SHAPE_L::SAW_UP> (fm, len);
+				break;
+			default:
+				lfo <MOD_SHAPE_L::SAW_DOWN> (fm, len);
+				break;
+		}
+	} else if (source == (int)MOD_SRC_L::ENVELOPE) {
+		TYPE e = env;
+		for (int i = 0; i < len; i++) {
+			TYPE a = 0.0;
+			for (int c = 0; c < ch; c++)
+				a = std::max (a, std::abs (xn [c][i]));
+			e += k * (a - e);
+			fm [i] = depth * e;
+		}
+		env = e;
+	} else {
+		for (int i = 0; i < len; i++)
+			fm [i] = 0.0;
+	}
+}
+
+template <typename TYPE, int TBL_BITS>
+template <MOD_SHAPE_L SHAPE>
+void
+AQModulator <TYPE, TBL_BITS>:: 
+lfo (TYPE* fm, const int len)
+{
+	constexpr TYPE PHASE_SCALE = 1.0 / 4'294'967'296.0;
+	constexpr TYPE FRAC_SCALE = 1.0 / (1 << FRAC_BITS);
+	uint32_t p = phase;
+	for (int i = 0; i < len; i++) {
+		TYPE m;
+		if constexpr (SHAPE == MOD_SHAPE_L::SINE) {
+			uint32_t n = p >> FRAC_BITS;
+			TYPE frac = (p & ((1u << FRAC_BITS) - 1)) * FRAC_SCALE;
+			m = SIN_TBL [n] + frac * (SIN_TBL [n + 1] - SIN_TBL [n]);
+		} else if constexpr (SHAPE == MOD_SHAPE_L::TRIANGLE) {
+			TYPE t = (uint32_t)(p + 0x4000'0000u) * PHASE_SCALE;	// starts at 0 upward
+			m = 1.0 - 4.0 * std::abs (t - 0.5);
+		} else {
+			TYPE t = (uint32_t)(p + 0x8000'0000u) * PHASE_SCALE;	// starts at 0
+			m = SHAPE == MOD_SHAPE_L::SAW_UP ? 2.0 * t - 1.0 : 1.0 - 2.0 * t;
+		}
+		fm [i] = depth * m;
+		p += phase_inc;
+	}
+	phase = p;
+}
+
+template <typename TYPE, int TBL_BITS>
+void
+AQModulator <TYPE, TBL_BITS>:: 
+reset ()
+{
+	phase = 0;
+	env = 0.0;
+}
+
+} // namespace suzumushi
@@ -0,0 +1,216 @@
+//
+// Copyright (c) 2026 suzumushi
+//
+// 2026-10-17		AQRotator.h
+//
+// Licensed under Creative Commons Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0).
+//
+// https://creativecommons.org/licenses/by-nc-sa/4.0/
+//
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+
+
+namespace suzumushi {
+
+// Recursive quadrature oscillator (complex rotator) for the sine carrier
+//
+// A phasor z = sqrt (2) * exp (j theta) is multiplied by w = exp (j 2 pi f / SR) every sample, and
+// yn = Im (z), yHn = - Re (z), i.e. the same sine carrier as AQDDS with exact quadrature and no table.
+// Blocks are generated in LANES interleaved phasors advanced by w^LANES, which vectorizes.
+// A 64 bit fractional phase (2^-64 cycle) runs along with the phasor. It is the reference of
+// setup () and ramp (), which re-seed z from it, so rounding errors of the recursion never accumulate
+// beyond one parameter update. The magnitudes of z and w are renormalized at the end of each block.
+// Frequency resolution is SR / 2^64 for the phase and about 1e-12 Hz for the rotation.
+// A linear frequency ramp multiplies w by a constant rotation r every sample (quadratic phase).
+
+template <typename TYPE, 
+	int LANES = 4>								// number of interleaved phasors of block generation
+class AQRotator {
+public:
+	void setup (const double samplingRate, const TYPE frequency);
+	void process (TYPE* yn, TYPE* yHn, const int len);
+	void ramp (const TYPE frequency, const int len);	// linear ramp to frequency in the next len samples
+	void reset ();
+	double get_phase () const;					// in cycles [0, 1), to hand the carrier over to another generator
+	void set_phase (const double cycles);		// after setup ()
+private:
+	static constexpr double CYCLE = 18'446'744'073'709'551'616.0;	// 2^64
+	uint64_t increment (const TYPE frequency) const;
+	void seed ();								// z and w from phase and phase_inc
+	void renormalize ();
+	uint64_t phase {0};							// phase in 2^-64 cycle
+	uint64_t phase_inc {0};						// phase increment per sample
+	double SR {0.0};							// sampling rate
+	TYPE zr {std::numbers::sqrt2};				// phasor
+	TYPE zi {0.0};
+	TYPE wr {1.0};								// rotation per sample
+	TYPE wi {0.0};
+	TYPE rr {1.0};								// rotation of w per sample during ramp
+	TYPE ri {0.0};
+	int64_t inc_diff {0};						// phase_inc difference per sample during ramp
+	uint64_t inc_end {0};						// phase_inc at the end of ramp
+	int ramp_len {0};							// remaining samples of ramp
+};
+
+template <typename TYPE, int LANES>
+uint64_t
+AQRotator <TYPE, LANES>:: 
+increment (const TYPE frequency) const
+{
+	// rounded like AQDDS and AQCompactDDS, and wrapped into one cycle so that the conversion is defined
+	double cycles = frequency / SR;
+	cycles -= std::floor (cycles);
+	double inc = std::floor (cycles * CYCLE + 0.5);
+	return (inc < CYCLE ? (uint64_t)inc : 0);
+}
+
+template <typename TYPE, int LANES>
+void
+AQRotator <TYPE, LANES>:: 
+seed ()
+{
+	TYPE theta = 2.0 * std::numbers::pi * (phase / CYCLE);
+	zr = std::numbers::sqrt2 * std::cos (theta);
+	zi = std::numbers::sqrt2 * std::sin (theta);
+	TYPE delta = 2.0 * std::numbers::pi * (phase_inc / CYCLE);
+	wr = std::cos (delta);
+	wi = std::sin (delta);
+}
+
+template <typename TYPE, int LANES>
+void
+AQRotator <TYPE, LANES>:: 
+setup (const double samplingRate, const TYPE frequency)
+{
+	if (samplingRate != SR) {
+		SR = samplingRate;
+		phase = 0;
+	}
+	phase_inc = increment (frequency);
+	ramp_len = 0;
+	seed ();
+}
+
+template <typename TYPE, int LANES>
+void
+AQRotator <TYPE, LANES>:: 
+ramp (const TYPE frequency, const int len)
+{
+	if (SR == 0.0 || len <= 0)
+		return;
+	inc_end = increment (frequency);
+	inc_diff = ((int64_t)(inc_end - phase_inc)) / len;
+	ramp_len = len;
+	seed ();
+	TYPE delta = 2.0 * std::numbers::pi * (inc_diff / CYCLE);
+	rr = std::cos (delta);
+	ri = std::sin (delta);
+}
+
+template <typename TYPE, int LANES>
+void
+AQRotator <TYPE, LANES>:: 
+process (TYPE* yn, TYPE* yHn, const int len)
+{
+	int i = 0;
+	// frequency ramp
+	for (; i < len && ramp_len > 0; i++) {
+		yn [i] = zi;
+		yHn [i] = - zr;
+		TYPE t = zr * wr - zi * wi;
+		zi = zr * wi + zi * wr;
+		zr = t;
+		phase += phase_inc;
+		if (--ramp_len == 0) {
+			phase_inc = inc_end;
+			seed ();
+		} else {
+			phase_inc += inc_diff;
+			t = wr * rr - wi * ri;
+			wi = wr * ri + wi * rr;
+			wr = t;
+		}
+	}
+
+	// constant frequency
+	const int blk_len = (len - i) / LANES * LANES;
+	if (blk_len > 0) {
+		TYPE lr [LANES], li [LANES];			// z * w^k
+		TYPE Wr = 1.0;							// w^LANES
+		TYPE Wi = 0.0;
+		for (int k = 0; k < LANES; k++) {
+			lr [k] = zr * Wr - zi * Wi;
+			li [k] = zr * Wi + zi * Wr;
+			TYPE t = Wr * wr - Wi * wi;
+			Wi = Wr * wi + Wi * wr;
+			Wr = t;
+		}
+		for (int end = i + blk_len; i < end; i += LANES)
+			for (int k = 0; k < LANES; k++) {
+				yn [i + k] = li [k];
+				yHn [i + k] = - lr [k];
+				TYPE t = lr [k] * Wr - li [k] * Wi;
+				li [k] = lr [k] * Wi + li [k] * Wr;
+				lr [k] = t;
+			}
+		zr = lr [0];
+		zi = li [0];
+		phase += phase_inc * blk_len;
+	}
+	for (; i < len; i++) {
+		yn [i] = zi;
+		yHn [i] = - zr;
+		TYPE t = zr * wr - zi * wi;
+		zi = zr * wi + zi * wr;
+		zr = t;
+		phase += phase_inc;
+	}
+	renormalize ();
+}
+
+template <typename TYPE, int LANES>
+void
+AQRotator <TYPE, LANES>:: 
+renormalize ()
+{
+	// one Newton step toward |z| = sqrt (2) and |w| = 1
+	TYPE gz = 1.5 - 0.25 * (zr * zr + zi * zi);
+	zr *= gz;
+	zi *= gz;
+	TYPE gw = 1.5 - 0.5 * (wr * wr + wi * wi);
+	wr *= gw;
+	wi *= gw;
+}
+
+template <typename TYPE, int LANES>
+double
+AQRotator <TYPE, LANES>:: 
+get_phase () const
+{
+	return (phase / CYCLE);
+}
+
+template <typename TYPE, int LANES>
+void
+AQRotator <TYPE, LANES>:: 
+set_phase (const double cycles)
+{
+	double p = std::floor (cycles * CYCLE + 0.5);
+	phase = p < CYCLE ? (uint64_t)p : 0;
+	seed ();
+}
+
+template <typename TYPE, int LANES>
+void
+AQRotator <TYPE, LANES>:: 
+reset ()
+{
+	SR = 0.0;
+}
+
+} // namespace suzumushi
@@ -1,7 +1,7 @@
 //
 // Copyright (c) 2023 suzumushi
 //
-// 2023-10-16		AQcontroller.cpp
+// 2026-10-17		AQcontroller.cpp
 //
 // Licensed under Creative Commons Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0).
 //
@@ -108,11 +108,58 @@ tresult PLUGIN_API AudioQAMController:: initialize (FUnknown* context)
 	wet_param -> setPrecision (precision2);
 	parameters.addParameter (wet_param);
 
+	Vst::StringListParameter* ht_mode_param = new Vst::StringListParameter (
+		STR16 ("Hilbert transformer mode"), ht_mode.tag, nullptr, ht_mode.flags);
+	ht_mode_param -> appendString (STR16 ("Linear phase"));
+	ht_mode_param -> appendString (STR16 ("Low latency"));
+	parameters.addParameter (ht_mode_param);
+
+	Vst::StringListParameter* ht_quality_param = new Vst::StringListParameter (
+		STR16 ("Hilbert transformer quality"), ht_quality.tag, nullptr, ht_quality.flags);
+	ht_quality_param -> appendString (STR16 ("Draft (259 taps)"));
+	ht_quality_param -> appendString (STR16 ("Normal (515 taps)"));
+	ht_quality_param -> appendString (STR16 ("High (771 taps)"));
+	ht_quality_param -> appendString (STR16 ("Exact (1,539 taps)"));
+	parameters.addParameter (ht_quality_param);
+
+	Vst::StringListParameter* mod_src_param = new Vst::StringListParameter (
+		STR16 ("Modulation source"), mod_src.tag, nullptr, mod_src.flags);
+	mod_src_param -> appendString (STR16 ("Off"));
+	mod_src_param -> appendString (STR16 ("LFO"));
+	mod_src_param -> appendString (STR16 ("Envelope"));
+	parameters.addParameter (mod_src_param);
+
+	Vst::StringListParameter* mod_shape_param = new Vst::StringListParameter (
+		STR16 ("LFO waveform"), mod_shape.tag, nullptr, mod_shape.flags);
+	mod_shape_param -> appendString (STR16 ("Sine"));
+	mod_shape_param -> appendString (STR16 ("Triangle"));
+	mod_shape_param -> appendString (STR16 ("Sawtooth up"));
+	mod_shape_param -> appendString (STR16 ("Sawtooth down"));
+	parameters.addParameter (mod_shape_param);
+
+	Vst::LogTaperParameter* mod_rate_param = new Vst::LogTaperParameter (
+		STR16 ("Modulation rate"), mod_rate.tag, STR16 ("Hz"),
+		mod_rate.min, mod_rate.max, mod_rate.def, mod_rate.steps, mod_rate.flags);
+	mod_rate_param -> setPrecision (precision2);
+	parameters.addParameter (mod_rate_param);
+
+	Vst::RangeParameter* mod_depth_param = new Vst::RangeParameter (
+		STR16 ("Modulation depth"), mod_depth.tag, STR16 ("Hz"),
+		mod_depth.min, mod_depth.max, mod_depth.def, mod_depth.steps, mod_depth.flags);
+	mod_depth_param -> setPrecision (precision1);
+	parameters.addParameter (mod_depth_param);
+
 	Vst::RangeParameter* bypass_param = new Vst::RangeParameter (
 		STR16 ("Bypass"), bypass.tag, nullptr,
 		bypass.min, bypass.max, bypass.def, bypass.steps, bypass.flags);
 	parameters.addParameter (bypass_param);
 
+	Vst::RangeParameter* latency_param = new Vst::RangeParameter (
+		STR16 ("Latency"), latency.tag, STR16 ("samples"),
+		latency.min, latency.max, latency.def, latency.steps, latency.flags);
+	latency_param -> setPrecision (precision0);
+	parameters.addParameter (latency_param);
+
 	return result;
 }
 
@@ -140,6 +187,8 @@ tresult PLUGIN_API AudioQAMController:: setComponentState (IBStream* state)
 
 	if (streamer.readInt32 (version) == false)
 		return (kResultFalse);
+	if (version < 0 || version > STATE_VERSION)	// unknown, e.g. of a future version
+		return (kResultFalse);
 
 	if (streamer.readDouble (dtmp) == false)
 		return (kResultFalse);
@@ -193,6 +242,42 @@ tresult PLUGIN_API AudioQAMController:: setComponentState (IBStream* state)
 		return (kResultFalse);
 	setParamNormalized (bypass.tag, plainParamToNormalized (bypass.tag, (ParamValue)itmp));
 
+	if (version <= 1)
+		itmp = (int32) HT_MODE_L::LINEAR_PHASE;
+	else {
+		if (streamer.readInt32 (itmp) == false)
+			return (kResultFalse);
+	}
+	setParamNormalized (ht_mode.tag, plainParamToNormalized (ht_mode.tag, (ParamValue)itmp));
+
+	if (version <= 2)
+		itmp = (int32) HT_QUALITY_L::HIGH;
+	else {
+		if (streamer.readInt32 (itmp) == false)
+			return (kResultFalse);
+	}
+	setParamNormalized (ht_quality.tag, plainParamToNormalized (ht_quality.tag, (ParamValue)itmp));
+
+	if (version <= 3) {
+		setParamNormalized (mod_src.tag, plainParamToNormalized (mod_src.tag, (ParamValue)MOD_SRC_L::OFF));
+		setParamNormalized (mod_shape.tag, plainParamToNormalized (mod_shape.tag, (ParamValue)MOD_SHAPE_L::SINE));
+		setParamNormalized (mod_rate.tag, plainParamToNormalized (mod_rate.tag, mod_rate.def));
+		setParamNormalized (mod_depth.tag, plainParamToNormalized (mod_depth.tag, mod_depth.def));
+	} else {
+		if (streamer.readInt32 (itmp) == false)
+			return (kResultFalse);
+		setParamNormalized (mod_src.tag, plainParamToNormalized (mod_src.tag, (ParamValue)itmp));
+		if (streamer.readInt32 (itmp) == false)
+			return (kResultFalse);
+		setParamNormalized (mod_shape.tag, plainParamToNormalized (mod_shape.tag, (ParamValue)itmp));
+		if (streamer.readDouble (dtmp) == false)
+			return (kResultFalse);
+		setParamNormalized (mod_rate.tag, plainParamToNormalized (mod_rate.tag, dtmp));
+		if (streamer.readDouble (dtmp) == false)
+			return (kResultFalse);
+		setParamNormalized (mod_depth.tag, plainParamToNormalized (mod_depth.tag, dtmp));
+	}
+
 	return kResultOk;
 }
 
@@ -235,7 +320,14 @@ IPlugView* PLUGIN_API AudioQAMController:: createView (FIDString name)
 tresult PLUGIN_API AudioQAMController:: setParamNormalized (Vst::ParamID tag, Vst::ParamValue value)
 {
 	// called by host to update your parameters
+
+	// suzumushi: latency is reported by the processor after it has applied Hilbert transformer mode
+	// and quality, so that the host gets the new latency by getLatencySamples ()
+	bool latency_changed = (tag == latency.tag && getParamNormalized (tag) != value);
+
 	tresult result = EditControllerEx1::setParamNormalized (tag, value);
+	if (result == kResultOk && latency_changed && componentHandler)
+		componentHandler->restartComponent (Vst::kLatencyChanged);
 	return result;
 }
 
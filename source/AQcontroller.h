@@ -1,7 +1,7 @@
 //
 // Copyright (c) 2023 suzumushi
 //
-// 2023-3-12		AQcontroller.h
+// 2026-10-17		AQcontroller.h
 //
 // Licensed under Creative Commons Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0).
 //
@@ -14,6 +14,7 @@
 
 // suzumushi: 
 #include "AQparam.h"
+#include "SOextparam.h"
 
 namespace suzumushi {
 
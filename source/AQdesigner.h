@@ -0,0 +1,323 @@
+//
+// Copyright (c) 2026 suzumushi
+//
+// 2026-10-17		AQdesigner.h
+//
+// Licensed under Creative Commons Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0).
+//
+// https://creativecommons.org/licenses/by-nc-sa/4.0/
+//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "AQBLtables.h"
+#include "SOSPSCqueue.h"
+#include "SOcoefcache.h"
+#include "SO2ndordIIRfilters.h"
+
+
+namespace suzumushi {
+
+// background coefficient designer of input and output filters
+//
+// The audio thread posts a request with the latest cutoff frequencies by request_design () and picks up
+// the designed coefficients by fetch (), both through lock-free SPSC queues. So that sin, cos, tan and pow
+// of the filter design never run in process (). Requests queued while the designer is busy are merged
+// into one, and only the latest frequencies are designed.
+// The designer thread looks up coefficients in a SOcoef_cache of each filter type first, so cutoffs
+// are quantized to 1/48 octave. A PREWARM request fills the caches for a sampling rate, and a BL_TABLES
+// request builds the band-limited tables of AQBLtables shared by all instances.
+// While requests come, the designer polls the request queue at intervals from POLL_MIN_MS after a request,
+// backing off to POLL_MAX_MS, so that the audio thread does not wake it up, which could be a system call.
+// After PARK_MS without requests, the designer parks on an atomic wait, and idle instances make no
+// wakeups. The first request after parking wakes it up (a system call of the audio thread once per idle
+// period), and so do stop () and setup () of AQEngine from other threads. Results carry the sampling rate
+// of their request, so that the audio thread can drop stale ones.
+
+template <typename I_HPF_T,		// AQFIRfilters (linear phase input HPF)
+	typename I_MPHPF_T,			// SOHPF (minimum phase input HPF, two sections)
+	typename I_LPF_T,			// SOLPF
+	typename O_HPF_T,			// SOHPF
+	typename O_LPF_T>			// SOLPF
+class AQdesigner {
+public:
+	// targets
+	static constexpr int I_HPF = 1;
+	static constexpr int I_LPF = 2;
+	static constexpr int O_HPF = 4;
+	static constexpr int O_LPF = 8;
+	static constexpr int ALL = I_HPF | I_LPF | O_HPF | O_LPF;
+	static constexpr int PREWARM = 16;					// fill coefficient caches for SR
+	static constexpr int BL_TABLES = 32;				// build AQBLtables <double>
+
+	static constexpr double MP_HPF_Q [2] = {0.54119610, 1.30656296};	// 4th-order Butterworth
+
+	struct request {
+		double SR;
+		double i_h_freq;
+		double i_l_freq;
+		double o_h_freq;
+		double o_l_freq;
+		int targets;
+	};
+	struct coef_set {
+		double SR;										// of the request
+		int targets;
+		typename I_HPF_T::coefs i_hpf;
+		SObiquad_coefs <double> i_mphpf [2];
+		SObiquad_coefs <double> i_lpf;
+		SObiquad_coefs <double> o_hpf;
+		SObiquad_coefs <double> o_lpf;
+	};
+
+	~AQdesigner ();
+	void start ();
+	void stop ();
+	bool request_design (const request& req);			// audio thread, or any thread while process () is not called.
+														// returns false if the queue is full
+	void wake ();										// any thread. a system call only if the designer is parked
+	bool fetch (coef_set& coefs);						// audio thread. returns false if nothing is designed
+	static void design (const request& req, coef_set& coefs);	// any thread, without caches
+	unsigned long long cache_hits () const;
+	unsigned long long cache_misses () const;
+private:
+	void run ();
+	void cached_design (const request& req, coef_set& coefs);		// designer thread
+	void prewarm (const double SR);									// designer thread
+	static void design_i_hpf (typename I_HPF_T::coefs& coefs, const double SR, const double fc)
+	{
+		I_HPF_T::design (coefs, SR, fc);
+	}
+	static void design_i_mphpf_0 (SObiquad_coefs <double>& coefs, const double SR, const double fc)
+	{
+		coefs = I_MPHPF_T::design (SR, fc, MP_HPF_Q [0]);
+	}
+	static void design_i_mphpf_1 (SObiquad_coefs <double>& coefs, const double SR, const double fc)
+	{
+		coefs = I_MPHPF_T::design (SR, fc, MP_HPF_Q [1]);
+	}
+	static void design_i_lpf (SObiquad_coefs <double>& coefs, const double SR, const double fc)
+	{
+		coefs = I_LPF_T::design (SR, fc);
+	}
+	static void design_o_hpf (SObiquad_coefs <double>& coefs, const double SR, const double fc)
+	{
+		coefs = O_HPF_T::design (SR, fc);
+	}
+	static void design_o_lpf (SObiquad_coefs <double>& coefs, const double SR, const double fc)
+	{
+		coefs = O_LPF_T::design (SR, fc);
+	}
+	SOcoef_cache <typename I_HPF_T::coefs>	i_hpf_cache;
+	SOcoef_cache <SObiquad_coefs <double>>	i_mphpf_cache [2];
+	SOcoef_cache <SObiquad_coefs <double>>	i_lpf_cache;
+	SOcoef_cache <SObiquad_coefs <double>>	o_hpf_cache;
+	SOcoef_cache <SObiquad_coefs <double>>	o_lpf_cache;
+	SOSPSCqueue <request> requests;
+	SOSPSCqueue <coef_set> results;
+	static constexpr int POLL_MIN_MS = 1;				// polling interval of the request queue [ms]
+	static constexpr int POLL_MAX_MS = 8;
+	static constexpr int PARK_MS = 256;					// idle time until the designer parks [ms]
+	std::atomic <bool> quit {false};
+	std::atomic <bool> parked {false};					// waiting for wake ()
+	std::thread worker;
+};
+
+template <typename I_HPF_T, typename I_MPHPF_T, typename I_LPF_T, typename O_HPF_T, typename O_LPF_T>
+AQdesigner <I_HPF_T, I_MPHPF_T, I_LPF_T, O_HPF_T, O_LPF_T>::
+~AQdesigner ()
+{
+	stop ();
+}
+
+template <typename I_HPF_T, typename I_MPHPF_T, typename I_LPF_T, typename O_HPF_T, typename O_LPF_T>
+void
+AQdesigner <I_HPF_T, I_MPHPF_T, I_LPF_T, O_HPF_T, O_LPF_T>::
+start ()
+{
+	if (! worker.joinable ()) {
+		quit.store (false);
+		worker = std::thread (&AQdesigner::run, this);
+	}
+}
+
+template <typename I_HPF_T, typename I_MPHPF_T, typename I_LPF_T, typename O_HPF_T, typename O_LPF_T>
+void
+AQdesigner <I_HPF_T, I_MPHPF_T, I_LPF_T, O_HPF_T, O_LPF_T>::
+stop ()
+{
+	if (worker.joinable ()) {
+		quit.store (true);
+		wake ();
+		worker.join ();
+	}
+}
+
+template <typename I_HPF_T, typename I_MPHPF_T, typename I_LPF_T, typename O_HPF_T, typename O_LPF_T>
+bool
+AQdesigner <I_HPF_T, I_MPHPF_T, I_LPF_T, O_HPF_T, O_LPF_T>::
+request_design (const request& req)
+{
+	// the designer finds the request by polling, and is woken up only if it is parked
+	if (! requests.push (req))
+		return (false);
+	wake ();
+	return (true);
+}
+
+template <typename I_HPF_T, typename I_MPHPF_T, typename I_LPF_T, typename O_HPF_T, typename O_LPF_T>
+void
+AQdesigner <I_HPF_T, I_MPHPF_T, I_LPF_T, O_HPF_T, O_LPF_T>::
+wake ()
+{
+	// pairs with the fence of run (), either the designer finds the request or parked is seen
+	std::atomic_thread_fence (std::memory_order_seq_cst);
+	if (parked.load (std::memory_order_relaxed) && parked.exchange (false))
+		parked.notify_one ();
+}
+
+template <typename I_HPF_T, typename I_MPHPF_T, typename I_LPF_T, typename O_HPF_T, typename O_LPF_T>
+bool
+AQdesigner <I_HPF_T, I_MPHPF_T, I_LPF_T, O_HPF_T, O_LPF_T>::
+fetch (coef_set& coefs)
+{
+	return (results.pop (coefs));
+}
+
+template <typename I_HPF_T, typename I_MPHPF_T, typename I_LPF_T, typename O_HPF_T, typename O_LPF_T>
+void
+AQdesigner <I_HPF_T, I_MPHPF_T, I_LPF_T, O_HPF_T, O_LPF_T>::
+design (const request& req, coef_set& coefs)
+{
+	coefs.SR = req.SR;
+	coefs.targets = req.targets & ALL;
+	if (req.targets & BL_TABLES)
+		AQBLtables <double>::build ();
+	if (req.targets & I_HPF) {
+		I_HPF_T::design (coefs.i_hpf, req.SR, req.i_h_freq);
+		for (int i = 0; i < 2; i++)
+			coefs.i_mphpf [i] = I_MPHPF_T::design (req.SR, req.i_h_freq, MP_HPF_Q [i]);
+	}
+	if (req.targets & I_LPF)
+		coefs.i_lpf = I_LPF_T::design (req.SR, req.i_l_freq);
+	if (req.targets & O_HPF)
+		coefs.o_hpf = O_HPF_T::design (req.SR, req.o_h_freq);
+	if (req.targets & O_LPF)
+		coefs.o_lpf = O_LPF_T::design (req.SR, req.o_l_freq);
+}
+
+template <typename I_HPF_T, typename I_MPHPF_T, typename I_LPF_T, typename O_HPF_T, typename O_LPF_T>
+void
+AQdesigner <I_HPF_T, I_MPHPF_T, I_LPF_T, O_HPF_T, O_LPF_T>::
+cached_design (const request& req, coef_set& coefs)
+{
+	coefs.SR = req.SR;
+	coefs.targets = req.targets & ALL;
+	if (req.targets & I_HPF) {
+		i_hpf_cache.get (coefs.i_hpf, req.SR, req.i_h_freq, design_i_hpf);
+		i_mphpf_cache [0].get (coefs.i_mphpf [0], req.SR, req.i_h_freq, design_i_mphpf_0);
+		i_mphpf_cache [1].get (coefs.i_mphpf [1], req.SR, req.i_h_freq, design_i_mphpf_1);
+	}
+	if (req.targets & I_LPF) {
+		if (I_LPF_T::pass_through_at (req.i_l_freq))	// not to be quantized below pass through frequency
+			coefs.i_lpf = I_LPF_T::design (req.SR, req.i_l_freq);
+		else
+			i_lpf_cache.get (coefs.i_lpf, req.SR, req.i_l_freq, design_i_lpf);
+	}
+	if (req.targets & O_HPF)
+		o_hpf_cache.get (coefs.o_hpf, req.SR, req.o_h_freq, design_o_hpf);
+	if (req.targets & O_LPF) {
+		if (O_LPF_T::pass_through_at (req.o_l_freq))
+			coefs.o_lpf = O_LPF_T::design (req.SR, req.o_l_freq);
+		else
+			o_lpf_cache.get (coefs.o_lpf, req.SR, req.o_l_freq, design_o_lpf);
+	}
+}
+
+template <typename I_HPF_T, typename I_MPHPF_T, typename I_LPF_T, typename O_HPF_T, typename O_LPF_T>
+void
+AQdesigner <I_HPF_T, I_MPHPF_T, I_LPF_T, O_HPF_T, O_LPF_T>::
+prewarm (const double SR)
+{
+	i_hpf_cache.prewarm (SR, design_i_hpf);
+	i_mphpf_cache [0].prewarm (SR, design_i_mphpf_0);
+	i_mphpf_cache [1].prewarm (SR, design_i_mphpf_1);
+	i_lpf_cache.prewarm (SR, design_i_lpf);
+	o_hpf_cache.prewarm (SR, design_o_hpf);
+	o_lpf_cache.prewarm (SR, design_o_lpf);
+}
+
+template <typename I_HPF_T, typename I_MPHPF_T, typename I_LPF_T, typename O_HPF_T, typename O_LPF_T>
+unsigned long long
+AQdesigner <I_HPF_T, I_MPHPF_T, I_LPF_T, O_HPF_T, O_LPF_T>::
+cache_hits () const
+{
+	return (i_hpf_cache.hits () + i_mphpf_cache [0].hits () + i_mphpf_cache [1].hits () +
+		i_lpf_cache.hits () + o_hpf_cache.hits () + o_lpf_cache.hits ());
+}
+
+template <typename I_HPF_T, typename I_MPHPF_T, typename I_LPF_T, typename O_HPF_T, typename O_LPF_T>
+unsigned long long
+AQdesigner <I_HPF_T, I_MPHPF_T, I_LPF_T, O_HPF_T, O_LPF_T>::
+cache_misses () const
+{
+	return (i_hpf_cache.misses () + i_mphpf_cache [0].misses () + i_mphpf_cache [1].misses () +
+		i_lpf_cache.misses () + o_hpf_cache.misses () + o_lpf_cache.misses ());
+}
+
+template <typename I_HPF_T, typename I_MPHPF_T, typename I_LPF_T, typename O_HPF_T, typename O_LPF_T>
+void
+AQdesigner <I_HPF_T, I_MPHPF_T, I_LPF_T, O_HPF_T, O_LPF_T>::
+run ()
+{
+	int poll_ms = POLL_MAX_MS;
+	int idle_ms = 0;
+	request req, next;
+	coef_set coefs;
+	for (;;) {
+		if (quit.load ())
+			return;
+		if (! requests.pop (req)) {
+			if (idle_ms < PARK_MS) {
+				std::this_thread::sleep_for (std::chrono::milliseconds (poll_ms));
+				idle_ms += poll_ms;
+				poll_ms = std::min (poll_ms * 2, POLL_MAX_MS);
+				continue;
+			}
+			// parked until wake (), after the last look at the queue
+			parked.store (true);
+			std::atomic_thread_fence (std::memory_order_seq_cst);
+			if (! requests.pop (req)) {
+				if (! quit.load ())
+					parked.wait (true);
+				parked.store (false);
+				continue;
+			}
+			parked.store (false);
+		}
+		poll_ms = POLL_MIN_MS;
+		idle_ms = 0;
+		while (requests.pop (next)) {		// merge into the latest request
+			next.targets |= req.targets;
+			req = next;
+		}
+		if (req.targets & PREWARM)
+			prewarm (req.SR);
+		if (req.targets & BL_TABLES)
+			AQBLtables <double>::build ();
+		if ((req.targets & ALL) == 0)
+			continue;
+		cached_design (req, coefs);
+		while (! results.push (coefs)) {	// the audio thread is not running
+			if (quit.load ())
+				return;
+			std::this_thread::sleep_for (std::chrono::milliseconds (1));
+		}
+	}
+}
+
+} // namespace suzumushi
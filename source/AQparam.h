@@ -1,7 +1,7 @@
 //
 // Copyright (c) 2023 suzumushi
 //
-// 2023-5-10		AQparam.h
+// 2026-10-17		AQparam.h
 //
 // Licensed under Creative Commons Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0).
 //
@@ -10,7 +10,7 @@
 
 #pragma once
 
-#include "SOextparam.h"
+#include "SOparamdef.h"
 
 
 namespace suzumushi {
@@ -28,6 +28,13 @@ constexpr ParamID I_L_FREQ {12};		// input LPF cutoff frequency [Hz]
 constexpr ParamID O_H_FREQ {14};		// output HPF cutoff frequency [Hz]
 constexpr ParamID O_L_FREQ {16};		// output LPF cutoff frequency [Hz]
 constexpr ParamID WET {18};				// wet/dry
+constexpr ParamID HT_MODE {20};			// Hilbert transformer mode
+constexpr ParamID HT_QUALITY {22};		// Hilbert transformer quality (impulse response length)
+constexpr ParamID MOD_SRC {24};			// modulation source of carrier wave frequency
+constexpr ParamID MOD_SHAPE {26};		// LFO waveform
+constexpr ParamID MOD_RATE {28};		// LFO frequency or envelope follower cutoff frequency [Hz]
+constexpr ParamID MOD_DEPTH {30};		// frequency deviation at full modulation [Hz]
+constexpr ParamID LATENCY {32};			// latency [samples], reported by processor
 constexpr ParamID BYPASS {255};			// bypass flag
 
 // attributes of GUI and host facing parameter
@@ -151,6 +158,75 @@ constexpr struct rangeParameter wet = {
 	{ParameterInfo::kCanAutomate}		// flags
 };
 
+constexpr struct stringListParameter ht_mode = {
+	HT_MODE,							// tag
+	{ParameterInfo::kIsList}			// flags, not automatable since latency changes
+};
+enum class HT_MODE_L {
+	LINEAR_PHASE,						// FIR Hilbert transformer and linear phase input HPF
+	LOW_LATENCY,						// IIR Hilbert transformer and minimum phase input HPF
+	LIST_LEN
+};
+
+constexpr struct stringListParameter ht_quality = {
+	HT_QUALITY,							// tag
+	{ParameterInfo::kIsList | ParameterInfo::kCanAutomate}	// flags
+};
+enum class HT_QUALITY_L {
+	DRAFT,
+	NORMAL,
+	HIGH,
+	EXACT,
+	LIST_LEN
+};
+constexpr int ht_quality_len [(unsigned int)HT_QUALITY_L::LIST_LEN] = {	// impulse response length
+	259,
+	515,
+	771,
+	1'539
+};
+
+constexpr struct stringListParameter mod_src = {
+	MOD_SRC,							// tag
+	{ParameterInfo::kIsList | ParameterInfo::kCanAutomate}	// flags
+};
+enum class MOD_SRC_L {
+	OFF,
+	LFO,
+	ENVELOPE,							// envelope of input signal
+	LIST_LEN
+};
+
+constexpr struct stringListParameter mod_shape = {
+	MOD_SHAPE,							// tag
+	{ParameterInfo::kIsList | ParameterInfo::kCanAutomate}	// flags
+};
+enum class MOD_SHAPE_L {
+	SINE,
+	TRIANGLE,
+	SAW_UP,
+	SAW_DOWN,
+	LIST_LEN
+};
+
+constexpr struct logTaperParameter mod_rate = {
+	MOD_RATE,							// tag
+	{0.1},								// min
+	{1'000.0},							// max
+	{1.0},								// default
+	{0},								// continuous
+	{ParameterInfo::kCanAutomate}		// flags
+};
+
+constexpr struct rangeParameter mod_depth = {
+	MOD_DEPTH,							// tag
+	{-3'200.0},							// min
+	{3'200.0},							// max
+	{0.0},								// default
+	{0},								// continuous
+	{ParameterInfo::kCanAutomate}		// flags
+};
+
 constexpr struct rangeParameter bypass = {
 	BYPASS,								// tag
 	{0.0},								// min, false
@@ -160,6 +236,19 @@ constexpr struct rangeParameter bypass = {
 	{ParameterInfo::kCanAutomate | ParameterInfo::kIsBypass}	// flags
 };
 
+constexpr struct rangeParameter latency = {
+	LATENCY,							// tag
+	{0.0},								// min
+	{1'000.0},							// max, longer than the latency of HT_QUALITY_L::EXACT
+	{0.0},								// default
+	{0},								// continuous
+	{ParameterInfo::kIsReadOnly | ParameterInfo::kIsHidden}	// flags, kLatencyChanged is raised by its change
+};
+
+// version of the state written by getState ()
+
+constexpr int32 STATE_VERSION {4};
+
 //  GUI and host facing parameters in processor class
 
 struct GUI_param {
@@ -184,6 +273,13 @@ struct GUI_param {
 	bool o_l_freq_changed;
 	ParamValue wet;
 	ParamValue dry;
+	int32 ht_mode;
+	int32 ht_quality;
+	int32 mod_src;
+	int32 mod_shape;
+	ParamValue mod_rate;
+	ParamValue mod_depth;
+	bool mod_changed;
 	int32 bypass;
 	bool reset;
 	bool load;		// for setState ()
@@ -209,6 +305,13 @@ struct GUI_param {
 		o_l_freq_changed = false;
 		wet = suzumushi::wet.def;
 		dry = 1.0 - suzumushi::wet.def;
+		ht_mode = (int32) HT_MODE_L::LINEAR_PHASE;
+		ht_quality = (int32) HT_QUALITY_L::HIGH;
+		mod_src = (int32) MOD_SRC_L::OFF;
+		mod_shape = (int32) MOD_SHAPE_L::SINE;
+		mod_rate = suzumushi::mod_rate.def;
+		mod_depth = suzumushi::mod_depth.def;
+		mod_changed = false;
 		bypass = suzumushi::bypass.def;
 		reset = true;
 		load = false;
@@ -1,7 +1,7 @@
 //
 // Copyright (c) 2023 suzumushi
 //
-// 2023-10-16		AQprocessor.cpp
+// 2026-10-17		AQprocessor.cpp
 //
 // Licensed under Creative Commons Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0).
 //
@@ -9,6 +9,7 @@
 //
 
 #include "AQprocessor.h"
+#include <algorithm>
 #include "AQcids.h"
 
 #include "base/source/fstreamer.h"
@@ -44,8 +45,11 @@ tresult PLUGIN_API AudioQAMProcessor:: initialize (FUnknown* context)
 
 	//--- create Audio IO ------
 	// suzumushi:
-	addAudioInput (STR16 ("Stereo In"), Steinberg::Vst::SpeakerArr::kStereo);
-	addAudioOutput (STR16 ("Stereo Out"), Steinberg::Vst::SpeakerArr::kStereo);
+	addAudioInput (STR16 ("Audio In"), Steinberg::Vst::SpeakerArr::kStereo);
+	addAudioOutput (STR16 ("Audio Out"), Steinberg::Vst::SpeakerArr::kStereo);
+	engine.set_channels (SpeakerArr::getChannelCount (Steinberg::Vst::SpeakerArr::kStereo));
+
+	engine.start ();
 
 	return kResultOk;
 }
@@ -55,6 +59,9 @@ tresult PLUGIN_API AudioQAMProcessor:: terminate ()
 {
 	// Here the Plug-in will be de-instantiated, last possibility to remove some memory!
 	
+	// suzumushi:
+	engine.stop ();
+
 	//---do not forget to call parent ------
 	return AudioEffect::terminate ();
 }
@@ -63,8 +70,12 @@ tresult PLUGIN_API AudioQAMProcessor:: terminate ()
 tresult PLUGIN_API AudioQAMProcessor:: setActive (TBool state)
 {
 	// suzumushi:
-	if (state != 0)				// if (state == true)
-		reset ();
+	if (state != 0) {			// if (state == true)
+		// per-channel instances for the bus arrangement, and initial coefficients
+		engine.set_channels (SpeakerArr::getChannelCount (getAudioOutput (0)->getArrangement ()));
+		engine.activate ();
+		latency_samples.store (engine.latency ());
+	}
 
 	//--- called when the Plug-in is enable/disable (On/Off) -----
 	return AudioEffect::setActive (state);
@@ -75,94 +86,107 @@ tresult PLUGIN_API AudioQAMProcessor:: process (Vst::ProcessData& data)
 {
 	//--- First : Read inputs parameter changes-----------
 
-    if (data.inputParameterChanges) {
-        int32 numParamsChanged = data.inputParameterChanges->getParameterCount ();
-        for (int32 index = 0; index < numParamsChanged; index++) {
-            if (auto* paramQueue = data.inputParameterChanges->getParameterData (index)) {
-                Vst::ParamValue value;
-                int32 sampleOffset;
-                int32 numPoints = paramQueue->getPointCount ();
-				// suzumushi: get the last change
-				if (paramQueue->getPoint (numPoints - 1, sampleOffset, value) == kResultTrue)
-					gui_param_update (paramQueue->getParameterId (), value);
-			}
-		}
-	}
+	// suzumushi: all points of all queues are read, and applied at their sample offsets
+	read_param_points (data.inputParameterChanges);
 
 	//--- Here you have to implement your processing
 
-	dsp_param_update (data.outputParameterChanges);
-
 	// numInputs == 0 and data.numOutputs == 0 mean parameters update only
-	if (data.numInputs == 0 || data.numOutputs == 0) {
-		return kResultOk;
-	}
-
-	// Speaker arrangements (stereo in and out are required) check.
-	if (data.inputs[0].numChannels < 2 || data.outputs[0].numChannels < 2) {
+	// Speaker arrangements (the channels of the bus arrangement are required) check.
+	const int32 channels = engine.get_channels ();
+	if (data.numInputs == 0 || data.numOutputs == 0 || 
+		data.inputs[0].numChannels < channels || data.outputs[0].numChannels < channels) {
+		for (int32 i = 0; i < points_len; i++)
+			gui_param_update (points [i].id, points [i].value);
+		dsp_param_update (data.outputParameterChanges, 0);
 		return kResultOk;
 	}
 
-	Vst::Sample32* in_L = data.inputs[0].channelBuffers32[0];
-	Vst::Sample32* in_R = data.inputs[0].channelBuffers32[1];
-	Vst::Sample32* out_L = data.outputs[0].channelBuffers32[0];
-	Vst::Sample32* out_R = data.outputs[0].channelBuffers32[1];
-
-	if (gp.bypass) {
-		// bypass mode
-		for (int32 i = 0; i < data.numSamples; i++) {
-			if (data.inputs[0].silenceFlags == 0) {
-				// all silenceFlags are false
-				*out_L++ = *in_L++;
-				*out_R++ = *in_R++;
-			} else {
-				// some silenceFlags are true
-				*out_L++ = *out_R++ = 0.0;
-				data.outputs[0].silenceFlags = data.inputs[0].silenceFlags;
+	// the block is split at the offsets of points
+	const GUI_param& gp = engine.params ();
+	uint64 silence_flags = ((uint64)1 << channels) - 1;
+	int32 p = 0;			// next point
+	int32 pos = 0;			// start of sub-block
+	do {
+		for (; p < points_len && points [p].offset <= pos; p++)
+			gui_param_update (points [p].id, points [p].value);
+		dsp_param_update (data.outputParameterChanges, pos);
+		int32 end = p < points_len ? std::min (points [p].offset, data.numSamples) : data.numSamples;
+
+		// linear ramps of c_freq and wet toward their next points
+		int32 offset;
+		ParamValue value;
+		double c_freq_end = gp.c_freq;
+		if (next_param_point (c_freq.tag, p, offset, value)) {
+			double update = to_plain (c_freq.tag, value);
+			c_freq_end += (update - gp.c_freq) * (end - pos) / (offset - pos);
+			if (gp.c_freq * c_freq_end < 0.0) {
+				// the sub-block ends at the zero crossing for side band switching
+				int32 cross = pos + (int32)((offset - pos) * gp.c_freq / (gp.c_freq - update) + 0.5);
+				end = std::clamp (cross, pos + 1, end);
+				c_freq_end = 0.0;
 			}
 		}
-	} else {
-		// DSP mode
-		for (int32 i = 0; i < data.numSamples; i++) {	
-			double xn, xHn;
-			DDS.process (gp.wform, xn, xHn);
-
-			DDL_L.enqueue (*in_L);
-			DDL_R.enqueue (*in_R);
-
-			double yn_L, yn_R;
-			yn_L = I_LPF_L.process (I_HPF_L.process (*in_L++));
-			yn_R = I_LPF_R.process (I_HPF_R.process (*in_R++));
-
-			double zn_L, zHn_L, zn_R, zHn_R;
-			HT_L.process (yn_L , zn_L, zHn_L);
-			HT_R.process (yn_R , zn_R, zHn_R);
-
-			if (gp.c_sb_switching && abs (xHn) < 0.01)	// side band switching noise reduction
-				gp.c_sb_switching = false;
-
-			if (! gp.c_sb_switching && gp.c_freq < 0.0 || gp.c_sb_switching && gp.c_freq >= 0.0) {	// LSB
-				yn_L = zn_L * xn + zHn_L * xHn;
-				yn_R = zn_R * xn + zHn_R * xHn;	
-			} else {									// USB
-				yn_L = zn_L * xn - zHn_L * xHn;
-				yn_R = zn_R * xn - zHn_R * xHn;	
-			}
+		double wet_end = gp.wet;
+		if (next_param_point (wet.tag, p, offset, value))
+			wet_end += (to_plain (wet.tag, value) - gp.wet) * (end - pos) / (offset - pos);
+
+		if (data.symbolicSampleSize == Vst::kSample64)
+			silence_flags &= dsp_process <Vst::Sample64> (data, pos, end - pos, c_freq_end, wet_end);
+		else
+			silence_flags &= dsp_process <Vst::Sample32> (data, pos, end - pos, c_freq_end, wet_end);
+		pos = end;
+	} while (pos < data.numSamples);
+
+	// points beyond the block
+	for (; p < points_len; p++)
+		gui_param_update (points [p].id, points [p].value);
+
+	data.outputs[0].silenceFlags = silence_flags;
+	return kResultOk;
+}
 
-			*out_L = gp.wet * O_LPF_L.process (O_HPF_L.process (yn_L));
-			*out_R = gp.wet * O_LPF_R.process (O_HPF_R.process (yn_R));
+template <typename SAMPLE>
+SAMPLE** AudioQAMProcessor:: channel_buffers (AudioBusBuffers& buffers)
+{
+	if constexpr (std::is_same_v <SAMPLE, Vst::Sample64>)
+		return (buffers.channelBuffers64);
+	else
+		return (buffers.channelBuffers32);
+}
 
-			*out_L++ += gp.dry * DDL_L.read ();
-			*out_R++ += gp.dry * DDL_R.read ();
-		}
+template <typename SAMPLE>
+uint64 AudioQAMProcessor:: dsp_process (ProcessData& data, const int32 offset, const int32 len, const double c_freq_end, const double wet_end)
+{
+	// the engine processes 64-bit samples without conversion
+	SAMPLE* in [AQEngine::MAX_CHANNELS];
+	SAMPLE* out [AQEngine::MAX_CHANNELS];
+	for (int32 k = 0; k < engine.get_channels (); k++) {
+		in [k] = channel_buffers <SAMPLE> (data.inputs[0])[k] + offset;
+		out [k] = channel_buffers <SAMPLE> (data.outputs[0])[k] + offset;
 	}
-	return kResultOk;
+	return (engine.process (in, out, len, data.inputs[0].silenceFlags, c_freq_end, wet_end));
+}
+
+//------------------------------------------------------------------------
+tresult PLUGIN_API AudioQAMProcessor:: setBusArrangements (SpeakerArrangement* inputs, int32 numIns, SpeakerArrangement* outputs, int32 numOuts)
+{
+	// suzumushi: any arrangement up to MAX_CHANNELS channels, the same for input and output
+	if (numIns != 1 || numOuts != 1 || inputs [0] != outputs [0])
+		return (kResultFalse);
+	int32 ch = SpeakerArr::getChannelCount (inputs [0]);
+	if (ch < 1 || ch > AQEngine::MAX_CHANNELS)
+		return (kResultFalse);
+	return AudioEffect::setBusArrangements (inputs, numIns, outputs, numOuts);
 }
 
 //------------------------------------------------------------------------
 tresult PLUGIN_API AudioQAMProcessor:: setupProcessing (Vst::ProcessSetup& newSetup)
 {
 	//--- called before any processing ----
+	// suzumushi: fill coefficient caches for the new sampling rate in the background,
+	// and offline rendering designs coefficients exactly and deterministically
+	engine.setup (newSetup.sampleRate, newSetup.processMode != Vst::kOffline);
 	return AudioEffect::setupProcessing (newSetup);
 }
 
@@ -173,13 +197,28 @@ tresult PLUGIN_API AudioQAMProcessor:: canProcessSampleSize (int32 symbolicSampl
 	if (symbolicSampleSize == Vst::kSample32)
 		return kResultTrue;
 
-	// disable the following comment if your processing support kSample64
-	/* if (symbolicSampleSize == Vst::kSample64)
-		return kResultTrue; */
+	// suzumushi: kSample64 is processed by the same dsp_process ()
+	if (symbolicSampleSize == Vst::kSample64)
+		return kResultTrue;
 
 	return kResultFalse;
 }
 
+//------------------------------------------------------------------------
+uint32 PLUGIN_API AudioQAMProcessor:: getLatencySamples ()
+{
+	// suzumushi: dry path is delayed to align with wet path in linear phase mode, and the latency of
+	// mode and quality applied by process () is reported, after which the controller raises kLatencyChanged
+	return (latency_samples.load ());
+}
+
+//------------------------------------------------------------------------
+uint32 PLUGIN_API AudioQAMProcessor:: getTailSamples ()
+{
+	// suzumushi: FIR and IIR tails of the current coefficients
+	return (engine.tail ());
+}
+
 //------------------------------------------------------------------------
 tresult PLUGIN_API AudioQAMProcessor:: setState (IBStream* state)
 {
@@ -193,6 +232,8 @@ tresult PLUGIN_API AudioQAMProcessor:: setState (IBStream* state)
 	int version;
 	if (streamer.readInt32 (version) == false)
 		return (kResultFalse);
+	if (version < 0 || version > STATE_VERSION)	// unknown, e.g. of a future version
+		return (kResultFalse);
 
 	if (streamer.readDouble (gp_load.c_freq) == false)
 		return (kResultFalse);
@@ -227,6 +268,36 @@ tresult PLUGIN_API AudioQAMProcessor:: setState (IBStream* state)
 	if (streamer.readInt32 (gp_load.bypass) == false)
 		return (kResultFalse);
 
+	if (version <= 1)
+		gp_load.ht_mode = (int32) HT_MODE_L::LINEAR_PHASE;
+	else {
+		if (streamer.readInt32 (gp_load.ht_mode) == false)
+			return (kResultFalse);
+	}
+
+	if (version <= 2)
+		gp_load.ht_quality = (int32) HT_QUALITY_L::HIGH;
+	else {
+		if (streamer.readInt32 (gp_load.ht_quality) == false)
+			return (kResultFalse);
+	}
+
+	if (version <= 3) {
+		gp_load.mod_src = (int32) MOD_SRC_L::OFF;
+		gp_load.mod_shape = (int32) MOD_SHAPE_L::SINE;
+		gp_load.mod_rate = mod_rate.def;
+		gp_load.mod_depth = mod_depth.def;
+	} else {
+		if (streamer.readInt32 (gp_load.mod_src) == false)
+			return (kResultFalse);
+		if (streamer.readInt32 (gp_load.mod_shape) == false)
+			return (kResultFalse);
+		if (streamer.readDouble (gp_load.mod_rate) == false)
+			return (kResultFalse);
+		if (streamer.readDouble (gp_load.mod_depth) == false)
+			return (kResultFalse);
+	}
+
 	gp_load.load = true;
 
 	return kResultOk;
@@ -239,7 +310,8 @@ tresult PLUGIN_API AudioQAMProcessor:: getState (IBStream* state)
 	IBStreamer streamer (state, kLittleEndian);
 
 	// suzumushi:
-	int version = 1;
+	const GUI_param& gp = engine.params ();
+	int version = STATE_VERSION;
 	if (streamer.writeInt32 (version) == false)
 		return (kResultFalse);
 
@@ -270,243 +342,147 @@ tresult PLUGIN_API AudioQAMProcessor:: getState (IBStream* state)
 	if (streamer.writeInt32 (gp.bypass) == false)
 		return (kResultFalse);
 
+	if (streamer.writeInt32 (gp.ht_mode) == false)
+		return (kResultFalse);
+	if (streamer.writeInt32 (gp.ht_quality) == false)
+		return (kResultFalse);
+
+	if (streamer.writeInt32 (gp.mod_src) == false)
+		return (kResultFalse);
+	if (streamer.writeInt32 (gp.mod_shape) == false)
+		return (kResultFalse);
+	if (streamer.writeDouble (gp.mod_rate) == false)
+		return (kResultFalse);
+	if (streamer.writeDouble (gp.mod_depth) == false)
+		return (kResultFalse);
+
 	return kResultOk;
 }
 //------------------------------------------------------------------------
 // suzumushi:
 
-void AudioQAMProcessor:: gui_param_loading ()
-{
-	if (gp_load.load) {
-		gp.c_freq = gp_load.c_freq;
-		gp.wform = gp_load.wform;
-		gp.auto_bl = gp_load.auto_bl;
-		gp.c_slide = gp_load.c_slide;
-		gp.c_range = gp_load.c_range;
-		gp.c_scale = gp_load.c_scale;
-		gp.i_h_freq = gp_load.i_h_freq;
-		gp.i_l_freq = gp_load.i_l_freq;
-		gp.o_h_freq = gp_load.o_h_freq;
-		gp.o_l_freq = gp_load.o_l_freq;
-		gp.wet = gp_load.wet;
-		gp.dry = 1.0 - gp.wet;
-		gp.bypass = gp_load.bypass;
-
-		gp_load.load = false;
-		reset ();
-	}
-}
-
-void AudioQAMProcessor:: gui_param_update (const ParamID paramID, const ParamValue paramValue)
+ParamValue AudioQAMProcessor:: to_plain (const ParamID paramID, const ParamValue paramValue)
 {
-	Vst::ParamValue update;
-
 	switch (paramID) {
 		case c_freq.tag:
-			update = rangeParameter::toPlain (paramValue, c_freq);
-			if (gp.c_freq != update) {
-				double sgn = gp.c_freq * update;
-				if (sgn < 0.0 || (sgn == 0.0 && (gp.c_freq < 0.0 || update < 0.0)))
-					gp.c_sb_switching = true;		// side band switching 
-				gp.c_freq = update;
-				gp.c_freq_changed = true;
-			}
-			break;
+			return (rangeParameter::toPlain (paramValue, c_freq));
 		case wform.tag:
-			gp.wform = stringListParameter::toPlain (paramValue, (int32)WFORM_L::LIST_LEN);
-			break;
+			return (stringListParameter::toPlain (paramValue, (int32)WFORM_L::LIST_LEN));
 		case auto_bl.tag:
-			gp.auto_bl = stringListParameter::toPlain (paramValue, (int32)AUTO_BL_L::LIST_LEN);
-			break;
+			return (stringListParameter::toPlain (paramValue, (int32)AUTO_BL_L::LIST_LEN));
 		case c_slide.tag:
-			update = rangeParameter::toPlain (paramValue, c_slide);
-			if (gp.c_slide != update) {
-				double sgn = gp.c_slide * update;
-				if (sgn < 0.0 || (sgn == 0.0 && (gp.c_slide < 0.0 || update < 0.0)))
-					gp.c_sb_switching = true;		// side band switching 
-				gp.c_slide = update;
-				gp.c_slide_changed = true;
-			}
-			break;
+			return (rangeParameter::toPlain (paramValue, c_slide));
 		case c_range.tag:
-			update = stringListParameter::toPlain (paramValue, (int32)C_RANGE_L::LIST_LEN);
-			if (gp.c_range != update) {
-				gp.c_range = update;
-				gp.c_range_changed = true;
-			}
-			break;
+			return (stringListParameter::toPlain (paramValue, (int32)C_RANGE_L::LIST_LEN));
 		case c_scale.tag:
-			update = stringListParameter::toPlain (paramValue, (int32)C_SCALE_L::LIST_LEN);
-			if (gp.c_scale != update) {
-				gp.c_scale = update;
-				gp.c_scale_changed = true;
-			}
-			break;
+			return (stringListParameter::toPlain (paramValue, (int32)C_SCALE_L::LIST_LEN));
 		case i_h_freq.tag:
-			update = Vst::LogTaperParameter::toPlain (paramValue, i_h_freq);
-			if (gp.i_h_freq != update) {
-				gp.i_h_freq = update;
-				gp.i_h_freq_changed = true;
-			}
-			break;
+			return (logTaperParameter::toPlain (paramValue, i_h_freq));
 		case i_l_freq.tag:
-			update = Vst::InfLogTaperParameter::toPlain (paramValue, i_l_freq);
-			if (gp.i_l_freq != update) {
-				gp.i_l_freq = update;
-				gp.i_l_freq_changed = true;
-			}
-			break;
+			return (logTaperParameter::toPlain (paramValue, i_l_freq));
 		case o_h_freq.tag:
-			update = Vst::LogTaperParameter::toPlain (paramValue, o_h_freq);
-			if (gp.o_h_freq != update) {
-				gp.o_h_freq = update;
-				gp.o_h_freq_changed = true;
-			}
-			break;
+			return (logTaperParameter::toPlain (paramValue, o_h_freq));
 		case o_l_freq.tag:
-			update = Vst::InfLogTaperParameter::toPlain (paramValue, o_l_freq);
-			if (gp.o_l_freq != update) {
-				gp.o_l_freq = update;
-				gp.o_l_freq_changed = true;
-			}
-			break;
+			return (logTaperParameter::toPlain (paramValue, o_l_freq));
 		case wet.tag:
-			gp.wet = rangeParameter::toPlain (paramValue, wet);
-			gp.dry = 1.0 - gp.wet;
-			break;
-		case bypass.tag:
-			gp.bypass = paramValue;
-			if (! gp.bypass)
-				reset ();
-			break;
+			return (rangeParameter::toPlain (paramValue, wet));
+		case ht_mode.tag:
+			return (stringListParameter::toPlain (paramValue, (int32)HT_MODE_L::LIST_LEN));
+		case ht_quality.tag:
+			return (stringListParameter::toPlain (paramValue, (int32)HT_QUALITY_L::LIST_LEN));
+		case mod_src.tag:
+			return (stringListParameter::toPlain (paramValue, (int32)MOD_SRC_L::LIST_LEN));
+		case mod_shape.tag:
+			return (stringListParameter::toPlain (paramValue, (int32)MOD_SHAPE_L::LIST_LEN));
+		case mod_rate.tag:
+			return (logTaperParameter::toPlain (paramValue, mod_rate));
+		case mod_depth.tag:
+			return (rangeParameter::toPlain (paramValue, mod_depth));
+		default:							// bypass
+			return (paramValue);
 	}
 }
 
-void AudioQAMProcessor:: dsp_param_update (IParameterChanges* outParam)
+void AudioQAMProcessor:: gui_param_update (const ParamID paramID, const ParamValue paramValue)
 {
-	int32 q_index = 0;		// paramQueue index
-	int32 p_index = 0;		// parameter index
-	int32 p_offset = 0;		// parameter offset
-
-	gui_param_loading ();
-
-	if (gp.reset || gp.c_freq_changed || gp.c_range_changed || gp.c_scale_changed) {
-		gp.c_range_changed = gp.c_scale_changed = gp.c_slide_changed = false;
-
-		if (gp.reset || gp.c_freq_changed) {
-			gp.c_freq_changed = true;
-			DDS.setup (processSetup.sampleRate, abs (gp.c_freq));
-		}
-
-		if (gp.c_freq >= c_range_val [gp.c_range])
-			gp.c_slide = 1.0;
-		else if (gp.c_freq <= - c_range_val [gp.c_range])
-			gp.c_slide = -1.0;
-		else {
-			if (gp.c_scale == (int32)C_SCALE_L::LINEAR)
-				gp.c_slide = abs (gp.c_freq) / c_range_val [gp.c_range];
-			else					// Logarithmic
-				gp.c_slide = Vst::LogTaperParameter::toNormalized (abs (gp.c_freq), 0.0, c_range_val [gp.c_range]);
-			if (gp.c_freq < 0.0)
-				gp.c_slide = - gp.c_slide;
-		}
-
-		// feedback gp.c_slide
-		if (outParam) {
-			IParamValueQueue* paramQueue = outParam->addParameterData (c_slide.tag, q_index);
-			if (paramQueue)
-				paramQueue->addPoint (p_offset, rangeParameter::toNormalized (gp.c_slide, c_slide), p_index);
-		}
-	}
-
-	if (gp.c_slide_changed) {
-		gp.c_slide_changed = false;
-		gp.c_freq_changed = true;
-		if (gp.c_scale == (int32)C_SCALE_L::LINEAR)		
-			gp.c_freq = abs (gp.c_slide) * c_range_val [gp.c_range];
-		else						// Logarithmic
-			gp.c_freq = Vst::LogTaperParameter::toPlain (abs (gp.c_slide), 0.0, c_range_val [gp.c_range]);
-		DDS.setup (processSetup.sampleRate, gp.c_freq);
-		if (gp.c_slide < 0.0)
-			gp.c_freq = - gp.c_freq;
-
-		// feedback gp.c_freq
-		if (outParam) {
-			IParamValueQueue* paramQueue = outParam->addParameterData (c_freq.tag, q_index);
-			if (paramQueue)
-				paramQueue->addPoint (p_offset, rangeParameter::toNormalized (gp.c_freq, c_freq), p_index);
-		}
-	}
+	engine.set_param (paramID, to_plain (paramID, paramValue));
+}
 
-	if (gp.c_freq_changed && gp.auto_bl == (int32)AUTO_BL_L::AUTOMATIC) {
-		if (gp.wform == (int32)WFORM_L::SINE) {
-			if (gp.c_freq < 0.0)
-				gp.i_h_freq = std::max (300.0 - gp.c_freq, i_h_freq.min);
-			else
-				gp.i_h_freq = i_h_freq.min;
-			gp.i_h_freq_changed = true;
-			// feedback i_h_freq
-			if (outParam) {
-				IParamValueQueue* paramQueue = outParam->addParameterData (i_h_freq.tag, q_index);
-				if (paramQueue)
-					paramQueue->addPoint (p_offset, InfLogTaperParameter::toNormalized (gp.i_h_freq, i_h_freq), p_index);
-			}
-		} else {
-			gp.i_l_freq = std::max (abs (gp.c_freq), i_l_freq.min);
-			gp.i_l_freq_changed = true;
-			// feedback i_l_freq
-			if (outParam) {
-				IParamValueQueue* paramQueue = outParam->addParameterData (i_l_freq.tag, q_index);
-				if (paramQueue)
-					paramQueue->addPoint (p_offset, InfLogTaperParameter::toNormalized (gp.i_l_freq, i_l_freq), p_index);
+void AudioQAMProcessor:: read_param_points (IParameterChanges* inParam)
+{
+	points_len = 0;
+	if (! inParam)
+		return;
+	int32 numParamsChanged = inParam->getParameterCount ();
+	for (int32 index = 0; index < numParamsChanged; index++) {
+		if (auto* paramQueue = inParam->getParameterData (index)) {
+			ParamID id = paramQueue->getParameterId ();
+			int32 numPoints = paramQueue->getPointCount ();
+			// only the last point is read, if all points don't fit into points []
+			for (int32 i = points_len + numPoints <= MAX_POINTS ? 0 : numPoints - 1; i < numPoints && points_len < MAX_POINTS; i++) {
+				param_point& point = points [points_len];
+				if (paramQueue->getPoint (i, point.offset, point.value) == kResultTrue) {
+					point.id = id;
+					point.order = points_len++;
+				}
 			}
 		}
 	}
-	gp.c_freq_changed = false;
+	std::sort (points, points + points_len, [] (const param_point& a, const param_point& b) {
+		return (a.offset < b.offset || (a.offset == b.offset && a.order < b.order));
+	});
+}
 
-	if (gp.reset || gp.i_h_freq_changed) {
-		gp.i_h_freq_changed = false;
-		I_HPF_L.setup (processSetup.sampleRate, gp.i_h_freq);
-		I_HPF_R.setup (processSetup.sampleRate, gp.i_h_freq);
-	}
+bool AudioQAMProcessor:: next_param_point (const ParamID paramID, const int32 from, int32& offset, ParamValue& value) const
+{
+	for (int32 i = from; i < points_len; i++)
+		if (points [i].id == paramID) {
+			offset = points [i].offset;
+			value = points [i].value;
+			return (true);
+		}
+	return (false);
+}
 
-	if (gp.reset || gp.i_l_freq_changed) {
-		gp.i_l_freq_changed = false;
-		I_LPF_L.setup (processSetup.sampleRate, gp.i_l_freq);
-		I_LPF_R.setup (processSetup.sampleRate, gp.i_l_freq);
+void AudioQAMProcessor:: dsp_param_update (IParameterChanges* outParam, const int32 offset)
+{
+	if (gp_load.load) {
+		engine.load (gp_load);
+		gp_load.load = false;
 	}
 
-	if (gp.reset || gp.o_h_freq_changed) {
-		gp.o_h_freq_changed = false;
-		O_HPF_L.setup (processSetup.sampleRate, gp.o_h_freq);
-		O_HPF_R.setup (processSetup.sampleRate, gp.o_h_freq);
+	int feedback = engine.update ();
+	int32 applied_latency = engine.latency ();
+	latency_samples.store (applied_latency);
+
+	if (! outParam)
+		return;
+	auto add_point = [outParam, offset] (const ParamID tag, const ParamValue normalized) {
+		int32 q_index = 0;		// paramQueue index
+		int32 p_index = 0;		// parameter index
+		IParamValueQueue* paramQueue = outParam->addParameterData (tag, q_index);
+		if (paramQueue)
+			paramQueue->addPoint (offset, normalized, p_index);
+	};
+
+	// latency of the applied mode and quality, the controller raises kLatencyChanged by its change
+	if (applied_latency != reported_latency) {
+		reported_latency = applied_latency;
+		add_point (latency.tag, rangeParameter::toNormalized (applied_latency, latency));
 	}
 
-	if (gp.reset || gp.o_l_freq_changed) {
-		gp.o_l_freq_changed = false;
-		O_LPF_L.setup (processSetup.sampleRate, gp.o_l_freq);
-		O_LPF_R.setup (processSetup.sampleRate, gp.o_l_freq);
+	// feedback of parameters changed by the engine
+	if (feedback != 0) {
+		const GUI_param& gp = engine.params ();
+		if (feedback & AQEngine::FB_C_SLIDE)
+			add_point (c_slide.tag, rangeParameter::toNormalized (gp.c_slide, c_slide));
+		if (feedback & AQEngine::FB_C_FREQ)
+			add_point (c_freq.tag, rangeParameter::toNormalized (gp.c_freq, c_freq));
+		if (feedback & AQEngine::FB_I_H_FREQ)
+			add_point (i_h_freq.tag, logTaperParameter::toNormalized (gp.i_h_freq, i_h_freq));
+		if (feedback & AQEngine::FB_I_L_FREQ)
+			add_point (i_l_freq.tag, logTaperParameter::toNormalized (gp.i_l_freq, i_l_freq));
 	}
-
-	gp.reset = false;
-}
-
-void AudioQAMProcessor:: reset ()
-{
-	DDS.reset ();
-	DDL_L.reset ();
-	DDL_R.reset ();
-	HT_L.reset ();
-	HT_R.reset ();
-	I_HPF_L.reset ();
-	I_HPF_R.reset ();
-	I_LPF_L.reset ();
-	I_LPF_R.reset ();
-	O_HPF_L.reset ();
-	O_HPF_R.reset ();
-	O_LPF_L.reset ();
-	O_LPF_R.reset ();
-	gp.reset = true;
 }
 
 //------------------------------------------------------------------------
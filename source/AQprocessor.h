@@ -1,7 +1,7 @@
 //
 // Copyright (c) 2023 suzumushi
 //
-// 2023-5-10		AQprocessor.h
+// 2026-10-17		AQprocessor.h
 //
 // Licensed under Creative Commons Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0).
 //
@@ -13,11 +13,8 @@
 #include "public.sdk/source/vst/vstaudioeffect.h"
 
 // suzumushi:
-#include "AQparam.h"
-#include "AQDDS.h"
-#include "AQHilbert.h"
-#include "AQFIRfilters.h"
-#include "SO2ndordIIRfilters.h"
+#include <atomic>
+#include "AQEngine.h"
 
 using namespace Steinberg;
 using namespace Vst;
@@ -51,6 +48,10 @@ public:
 	/** Switch the Plug-in on/off */
 	Steinberg::tresult PLUGIN_API setActive (Steinberg::TBool state) SMTG_OVERRIDE;
 
+	/** Try to set (host => plug-in) a wanted arrangement for inputs and outputs. */
+	Steinberg::tresult PLUGIN_API setBusArrangements (Steinberg::Vst::SpeakerArrangement* inputs, Steinberg::int32 numIns,
+		Steinberg::Vst::SpeakerArrangement* outputs, Steinberg::int32 numOuts) SMTG_OVERRIDE;
+
 	/** Will be called before any process call */
 	Steinberg::tresult PLUGIN_API setupProcessing (Steinberg::Vst::ProcessSetup& newSetup) SMTG_OVERRIDE;
 	
@@ -64,34 +65,42 @@ public:
 	Steinberg::tresult PLUGIN_API setState (Steinberg::IBStream* state) SMTG_OVERRIDE;
 	Steinberg::tresult PLUGIN_API getState (Steinberg::IBStream* state) SMTG_OVERRIDE;
 
+	/** Gets the current Latency in samples. */
+	Steinberg::uint32 PLUGIN_API getLatencySamples () SMTG_OVERRIDE;
+
+	/** Gets the current Tail size in samples. */
+	Steinberg::uint32 PLUGIN_API getTailSamples () SMTG_OVERRIDE;
+
 //------------------------------------------------------------------------
 protected:
 	// suzumushi: 
-	// GUI and host facing parameters
-	struct GUI_param gp;
+	// DSP chain, which holds GUI and host facing parameters
+	AQEngine engine;
 	struct GUI_param gp_load;						// for setState ()
+	std::atomic <int32> latency_samples {0};		// of the applied parameters, for getLatencySamples ()
+	int32 reported_latency {-1};					// latency parameter sent to the controller
 
-	// DSP instances 
-	static constexpr int HT_IR_LEN = 771;			// impulse response length of Hilbert transformer
-	AQDDS <double>									DDS;
-	SODDL <double, (HT_IR_LEN - 1) / 2>				DDL_L;
-	SODDL <double, (HT_IR_LEN - 1) / 2>				DDL_R;
-	AQHilbert <double, HT_IR_LEN>					HT_L;
-	AQHilbert <double, HT_IR_LEN>					HT_R;
-	AQFIRfilters <double, 131, false>				I_HPF_L;
-	AQFIRfilters <double, 131, false>				I_HPF_R;
-	SOLPF <double, i_l_freq.max>					I_LPF_L;
-	SOLPF <double, i_l_freq.max>					I_LPF_R;
-	SOHPF <double>									O_HPF_L;
-	SOHPF <double>									O_HPF_R;
-	SOLPF <double, o_l_freq.max>					O_LPF_L;
-	SOLPF <double, o_l_freq.max>					O_LPF_R;
+	// parameter changes of a process () call, sorted by sample offset
+	struct param_point {
+		int32 offset;
+		int32 order;								// order of reading for equal offsets
+		ParamID id;
+		ParamValue value;
+	};
+	static constexpr int32 MAX_POINTS = 1'024;
+	param_point points [MAX_POINTS];
+	int32 points_len {0};
 
 	// internal functions
-	void gui_param_loading ();
+	static ParamValue to_plain (const ParamID paramID, const ParamValue paramValue);
 	void gui_param_update (const ParamID paramID, const ParamValue paramValue);
-	void dsp_param_update (IParameterChanges* outParam);
-	void reset ();	
+	void dsp_param_update (IParameterChanges* outParam, const int32 offset);
+	void read_param_points (IParameterChanges* inParam);
+	bool next_param_point (const ParamID paramID, const int32 from, int32& offset, ParamValue& value) const;
+	template <typename SAMPLE>						// Sample32 or Sample64
+	uint64 dsp_process (ProcessData& data, const int32 offset, const int32 len, const double c_freq_end, const double wet_end);
+	template <typename SAMPLE>
+	static SAMPLE** channel_buffers (AudioBusBuffers& buffers);
 };
 
 //------------------------------------------------------------------------
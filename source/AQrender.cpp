@@ -0,0 +1,683 @@
+//
+// Copyright (c) 2026 suzumushi
+//
+// 2026-10-17		AQrender.cpp
+//
+// Licensed under Creative Commons Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0).
+//
+// https://creativecommons.org/licenses/by-nc-sa/4.0/
+//
+
+// aq_render: offline renderer of WAV and RF64 files by AQEngine
+//
+// The input is memory-mapped. Reading (conversion to planar double), DSP and writing run on three
+// threads, which pass NUM_BLOCKS block buffers around through SOSPSCqueue. The engine runs offline,
+// i.e. coefficients are exact and deterministic, and the output is not muted at the start. The latency
+// of linear phase mode is compensated, so that the output is aligned with the input.
+//
+// In batch mode (--batch), jobs of a manifest, i.e. files times parameter sets, run on SOworkpool. Each
+// worker renders a file at a time in its own thread, by an engine and buffers allocated only once.
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "AQEngine.h"
+#include "SOSPSCqueue.h"
+#include "SOwavfile.h"
+#include "SOworkpool.h"
+
+using namespace suzumushi;
+
+namespace {
+
+// command line flags of parameters, --name value
+
+constexpr const char* WFORM_NAMES [] = {"sine", "triangle", "square", "sawtooth"};
+constexpr const char* AUTO_BL_NAMES [] = {"manual", "automatic"};
+constexpr const char* C_RANGE_NAMES [] = {"r50", "r100", "r200", "r400", "r800", "r1600", "r3200"};
+constexpr const char* C_SCALE_NAMES [] = {"linear", "log"};
+constexpr const char* HT_MODE_NAMES [] = {"linear_phase", "low_latency"};
+constexpr const char* HT_QUALITY_NAMES [] = {"draft", "normal", "high", "exact"};
+constexpr const char* MOD_SRC_NAMES [] = {"off", "lfo", "envelope"};
+constexpr const char* MOD_SHAPE_NAMES [] = {"sine", "triangle", "saw_up", "saw_down"};
+static_assert (std::size (WFORM_NAMES) == (size_t)WFORM_L::LIST_LEN);
+static_assert (std::size (AUTO_BL_NAMES) == (size_t)AUTO_BL_L::LIST_LEN);
+static_assert (std::size (C_RANGE_NAMES) == (size_t)C_RANGE_L::LIST_LEN);
+static_assert (std::size (C_SCALE_NAMES) == (size_t)C_SCALE_L::LIST_LEN);
+static_assert (std::size (HT_MODE_NAMES) == (size_t)HT_MODE_L::LIST_LEN);
+static_assert (std::size (HT_QUALITY_NAMES) == (size_t)HT_QUALITY_L::LIST_LEN);
+static_assert (std::size (MOD_SRC_NAMES) == (size_t)MOD_SRC_L::LIST_LEN);
+static_assert (std::size (MOD_SHAPE_NAMES) == (size_t)MOD_SHAPE_L::LIST_LEN);
+
+struct param_flag {
+	const char* name;
+	ParamID tag;
+	double min;									// range of numerical parameters
+	double max;
+	const char* const* list;					// names of list items, nullptr for numerical parameters
+	int list_len;
+	const char* help;
+};
+
+template <size_t N>
+constexpr param_flag list_flag (const char* name, const stringListParameter& param, const char* const (&list) [N], const char* help)
+{
+	return (param_flag {name, param.tag, 0.0, N - 1.0, list, (int)N, help});
+}
+
+template <typename PARAM>
+constexpr param_flag range_flag (const char* name, const PARAM& param, const char* help)
+{
+	return (param_flag {name, param.tag, param.min, param.max, nullptr, 0, help});
+}
+
+constexpr param_flag param_flags [] = {
+	range_flag ("c_freq", c_freq, "carrier frequency [Hz], negative for lower side band"),
+	list_flag ("wform", wform, WFORM_NAMES, "carrier waveform"),
+	list_flag ("auto_bl", auto_bl, AUTO_BL_NAMES, "automatic input band-limiting by c_freq"),
+	range_flag ("c_slide", c_slide, "slider position, sets c_freq by c_range and c_scale"),
+	list_flag ("c_range", c_range, C_RANGE_NAMES, "slider range [Hz]"),
+	list_flag ("c_scale", c_scale, C_SCALE_NAMES, "slider scale"),
+	range_flag ("i_h_freq", i_h_freq, "input HPF cutoff frequency [Hz]"),
+	range_flag ("i_l_freq", i_l_freq, "input LPF cutoff frequency [Hz]"),
+	range_flag ("o_h_freq", o_h_freq, "output HPF cutoff frequency [Hz]"),
+	range_flag ("o_l_freq", o_l_freq, "output LPF cutoff frequency [Hz]"),
+	range_flag ("wet", wet, "wet/dry"),
+	list_flag ("ht_mode", ht_mode, HT_MODE_NAMES, "Hilbert transformer mode"),
+	list_flag ("ht_quality", ht_quality, HT_QUALITY_NAMES, "Hilbert transformer quality"),
+	list_flag ("mod_src", mod_src, MOD_SRC_NAMES, "modulation source of carrier frequency"),
+	list_flag ("mod_shape", mod_shape, MOD_SHAPE_NAMES, "LFO waveform"),
+	range_flag ("mod_rate", mod_rate, "LFO frequency or envelope follower cutoff [Hz]"),
+	range_flag ("mod_depth", mod_depth, "frequency deviation at full modulation [Hz]"),
+	range_flag ("bypass", bypass, "bypass"),
+};
+
+// parses a parameter value, a number or a name of list item
+bool parse_param (const param_flag& flag, const char* str, double& value)
+{
+	char* end;
+	value = std::strtod (str, &end);
+	if (end != str && *end == '\0')
+		return (flag.list ? value == (int)value && value >= 0.0 && value < flag.list_len : value >= flag.min && value <= flag.max);
+	for (int i = 0; i < flag.list_len; i++)
+		if (std::strcmp (str, flag.list [i]) == 0) {
+			value = i;
+			return (true);
+		}
+	return (false);
+}
+
+// finds the flag of a parameter by its name
+const param_flag* find_param_flag (const char* name)
+{
+	auto flag = std::find_if (std::begin (param_flags), std::end (param_flags),
+		[name] (const param_flag& f) {return (std::strcmp (name, f.name) == 0);});
+	return (flag == std::end (param_flags) ? nullptr : flag);
+}
+
+using param_list = std::vector <std::pair <const param_flag*, double>>;
+
+// parses --name value pairs of parameters from tokens [first]
+bool parse_params (const std::vector <std::string>& tokens, const size_t first, param_list& params, std::string& err)
+{
+	for (size_t i = first; i < tokens.size (); i += 2) {
+		const std::string& name = tokens [i];
+		const param_flag* flag = name.compare (0, 2, "--") == 0 ? find_param_flag (name.c_str () + 2) : nullptr;
+		double value;
+		if (! flag) {
+			err = "unknown parameter " + name;
+			return (false);
+		}
+		if (i + 1 == tokens.size ()) {
+			err = name + " requires a value";
+			return (false);
+		}
+		if (! parse_param (*flag, tokens [i + 1].c_str (), value)) {
+			err = "invalid value of " + name + ": " + tokens [i + 1];
+			return (false);
+		}
+		params.push_back ({flag, value});
+	}
+	return (true);
+}
+
+// output sample formats
+
+struct sample_format {
+	const char* name;
+	int bits;
+	bool is_float;
+};
+
+constexpr sample_format sample_formats [] = {
+	{"pcm16", 16, false},
+	{"pcm24", 24, false},
+	{"pcm32", 32, false},
+	{"float32", 32, true},
+	{"float64", 64, true},
+};
+
+void usage ()
+{
+	std::fprintf (stderr, "usage: aq_render [options] input.wav output.wav\n");
+	std::fprintf (stderr, "       aq_render [options] --batch manifest\n\n");
+	std::fprintf (stderr, "parameters (AQparam.h), in plain values:\n");
+	for (const auto& flag: param_flags) {
+		std::string range;
+		if (flag.list)
+			for (int i = 0; i < flag.list_len; i++)
+				range += std::string (i ? "|" : "") + flag.list [i];
+		else
+			range = std::to_string (flag.min) + " .. " + std::to_string (flag.max);
+		std::fprintf (stderr, "  --%-11s %s\n  %14s%s\n", flag.name, flag.help, "", range.c_str ());
+	}
+	std::fprintf (stderr, "\noptions:\n");
+	std::fprintf (stderr, "  --format     pcm16|pcm24|pcm32|float32|float64 (default: same as the input)\n");
+	std::fprintf (stderr, "  --block      frames of a block (default: 65536)\n");
+	std::fprintf (stderr, "  --tail       append the tail of filters to the output\n");
+	std::fprintf (stderr, "  --batch      render the jobs of a manifest on a work-stealing pool\n");
+	std::fprintf (stderr, "  --workers    workers of --batch (default: hardware concurrency)\n");
+	std::fprintf (stderr, "List items are also given by their indices, and parameters are applied in the\n"
+		"order of the flags. auto_bl=automatic overrides i_h_freq or i_l_freq, same as the plug-in.\n\n");
+	std::fprintf (stderr, "manifest (# starts a comment, and \"...\" quotes a path with white spaces):\n");
+	std::fprintf (stderr, "  set NAME [--parameter value ...]      a parameter set\n");
+	std::fprintf (stderr, "  INPUT OUTPUT [--parameter value ...]  a job, or a job for each set defined\n"
+		"                                        above if OUTPUT contains {set}\n");
+	std::fprintf (stderr, "Parameters of the command line are applied to every job first, then those of\n"
+		"the set and of the line.\n");
+}
+
+// blocking SOSPSCqueue, consumers sleep on an atomic counter
+
+template <typename TYPE>
+class stage_queue {
+public:
+	void push (const TYPE& val)
+	{
+		while (! queue.push (val))				// never full, with no more items than its capacity
+			std::this_thread::yield ();
+		signal.fetch_add (1, std::memory_order_release);
+		signal.notify_one ();
+	}
+	TYPE pop ()
+	{
+		for (;;) {
+			unsigned int seen = signal.load (std::memory_order_acquire);
+			TYPE val;
+			if (queue.pop (val))
+				return (val);
+			signal.wait (seen, std::memory_order_acquire);
+		}
+	}
+private:
+	SOSPSCqueue <TYPE> queue;
+	std::atomic <unsigned int> signal {0};
+};
+
+// a block buffer passed from the reader to the DSP and to the writer
+
+struct block {
+	std::vector <double> in;					// planar, channels * block_len
+	std::vector <double> out;
+	double* in_ch [AQEngine::MAX_CHANNELS];
+	double* out_ch [AQEngine::MAX_CHANNELS];
+	int len {0};								// frames of input
+	int out_offset {0};							// frames of output to be written
+	int out_len {0};
+	bool last {false};
+};
+
+constexpr int NUM_BLOCKS = 4;					// in flight, up to the capacity of SOSPSCqueue
+
+// options common to all jobs
+
+struct render_options {
+	const sample_format* format {nullptr};		// nullptr: same as the input
+	int block_len {65'536};
+	bool tail {false};
+};
+
+// a file to be rendered, and its result
+
+struct render_job {
+	std::string input;
+	std::string output;
+	param_list params;							// applied in order to the default parameters
+	long long size {0};							// bytes of input, larger jobs are scheduled first
+	bool ok {false};
+	std::string error;
+	long long frames {0};						// of output
+	int channels {0};
+	double duration {0.0};						// of input [s]
+	double elapsed {0.0};						// wall clock time of the job [s]
+};
+
+// an engine and block buffers, allocated once and reused for consecutive jobs
+//
+// Each job restarts the engine from the default parameters, so that its output does not depend on
+// previous jobs. Per-channel DSP instances and buffers grow to the largest job, and are kept.
+
+class renderer {
+public:
+	renderer ()
+	: engine (std::make_unique <AQEngine> ())	// about 1 MB with its Hilbert transformers
+	{}
+	// pipelined: reading, DSP and writing run on three threads, otherwise all in the calling thread
+	void render (render_job& job, const render_options& opt, const bool pipelined);
+private:
+	std::unique_ptr <AQEngine> engine;
+	block blocks [NUM_BLOCKS];
+};
+
+void renderer:: render (render_job& job, const render_options& opt, const bool pipelined)
+{
+	auto start = std::chrono::steady_clock::now ();
+
+	// files
+	SOwav_reader reader;
+	if (! reader.open (job.input.c_str ())) {
+		job.error = job.input + ": " + reader.error ();
+		return;
+	}
+	const SOwav_format& in_fmt = reader.format ();
+	const int channels = in_fmt.channels;
+	if (channels > AQEngine::MAX_CHANNELS) {
+		job.error = job.input + ": more than " + std::to_string (AQEngine::MAX_CHANNELS) + " channels";
+		return;
+	}
+	SOwav_format fmt = in_fmt;
+	if (opt.format) {
+		fmt.bits = opt.format->bits;
+		fmt.is_float = opt.format->is_float;
+	}
+	std::error_code ec;
+	if (std::filesystem::equivalent (job.input, job.output, ec)) {	// opening would truncate the mapped input
+		job.error = job.output + ": same file as the input";
+		return;
+	}
+	SOwav_writer writer;
+	if (! writer.open (job.output.c_str (), fmt)) {
+		job.error = job.output + ": " + writer.error ();
+		return;
+	}
+
+	// engine
+	engine->setup (in_fmt.sampling_rate, false);
+	engine->load (GUI_param ());				// default parameters, not those of the previous job
+	engine->set_channels (channels);
+	for (const auto& [flag, value]: job.params)
+		engine->set_param (flag->tag, value);
+	engine->activate ();
+	engine->update ();							// c_slide, auto_bl and coefficients of the parameters
+
+	// the first latency frames of the output are dropped, and the input is padded with zeros instead
+	const long long frames = reader.frames ();
+	const int latency = engine->params ().bypass ? 0 : engine->latency ();	// bypass is not delayed
+	const long long in_frames = frames + latency + (opt.tail ? engine->tail () : 0);
+	const int block_len = opt.block_len;
+
+	const int num_blocks = pipelined ? NUM_BLOCKS : 1;
+	for (int i = 0; i < num_blocks; i++) {
+		block& b = blocks [i];
+		b.in.resize ((size_t)channels * block_len);
+		b.out.resize ((size_t)channels * block_len);
+		for (int k = 0; k < channels; k++) {
+			b.in_ch [k] = b.in.data () + (size_t)k * block_len;
+			b.out_ch [k] = b.out.data () + (size_t)k * block_len;
+		}
+	}
+
+	// stages
+	long long read_pos = 0;
+	auto read_block = [&] (block& b) {
+		b.len = (int)std::min <long long> (block_len, in_frames - read_pos);
+		int file_len = (int)std::clamp <long long> (frames - read_pos, 0, b.len);
+		reader.read (read_pos, file_len, b.in_ch);
+		for (int k = 0; k < channels; k++)
+			std::fill (b.in_ch [k] + file_len, b.in_ch [k] + b.len, 0.0);
+		read_pos += b.len;
+		b.last = read_pos == in_frames;
+	};
+	int skip = latency;
+	auto dsp_block = [&] (block& b) {
+		engine->update ();
+		engine->process (b.in_ch, b.out_ch, b.len);
+		b.out_offset = std::min (skip, b.len);
+		b.out_len = b.len - b.out_offset;
+		skip -= b.out_offset;
+	};
+	bool write_ok = true;
+	auto write_block = [&] (block& b) {
+		const double* out [AQEngine::MAX_CHANNELS];
+		for (int k = 0; k < channels; k++)
+			out [k] = b.out_ch [k] + b.out_offset;
+		if (write_ok && b.out_len > 0)
+			write_ok = writer.write (out, b.out_len);
+	};
+
+	if (pipelined) {
+		stage_queue <int> free_q, read_q, done_q;
+		for (int i = 0; i < NUM_BLOCKS; i++)
+			free_q.push (i);
+
+		std::thread read_thread ([&] () {
+			while (read_pos < in_frames) {
+				int i = free_q.pop ();
+				read_block (blocks [i]);
+				read_q.push (i);
+			}
+		});
+
+		std::thread write_thread ([&] () {
+			for (bool last = in_frames == 0; ! last;) {
+				int i = done_q.pop ();
+				write_block (blocks [i]);
+				last = blocks [i].last;
+				free_q.push (i);
+			}
+		});
+
+		for (bool last = in_frames == 0; ! last;) {
+			int i = read_q.pop ();
+			dsp_block (blocks [i]);
+			last = blocks [i].last;
+			done_q.push (i);
+		}
+
+		read_thread.join ();
+		write_thread.join ();
+	} else
+		while (read_pos < in_frames) {
+			read_block (blocks [0]);
+			dsp_block (blocks [0]);
+			write_block (blocks [0]);
+		}
+
+	write_ok = writer.close () && write_ok;
+	if (! write_ok) {
+		job.error = job.output + ": " + writer.error ();
+		return;
+	}
+	job.ok = true;
+	job.frames = writer.frames ();
+	job.channels = channels;
+	job.duration = frames / in_fmt.sampling_rate;
+	job.elapsed = std::chrono::duration <double> (std::chrono::steady_clock::now () - start).count ();
+}
+
+// splits a line of manifest into tokens, returns false for an unterminated quote
+
+bool tokenize (const std::string& line, std::vector <std::string>& tokens)
+{
+	for (size_t i = 0; i < line.size ();) {
+		if (std::isspace ((unsigned char)line [i])) {
+			i++;
+			continue;
+		}
+		if (line [i] == '#')
+			break;
+		std::string token;
+		if (line [i] == '"') {
+			size_t end = line.find ('"', i + 1);
+			if (end == std::string::npos)
+				return (false);
+			token = line.substr (i + 1, end - i - 1);
+			i = end + 1;
+		} else
+			while (i < line.size () && ! std::isspace ((unsigned char)line [i]))
+				token += line [i++];
+		tokens.push_back (token);
+	}
+	return (true);
+}
+
+// reads jobs of a manifest, paths are relative to the current directory
+
+bool read_manifest (const char* path, std::vector <render_job>& jobs, std::string& err)
+{
+	std::ifstream file (path);
+	if (! file) {
+		err = std::string (path) + ": cannot open";
+		return (false);
+	}
+	struct param_set {
+		std::string name;
+		param_list params;
+	};
+	std::vector <param_set> sets;
+	const std::string SET_TAG = "{set}";
+	std::string line;
+	for (int line_no = 1; std::getline (file, line); line_no++) {
+		std::vector <std::string> tokens;
+		std::string msg;
+		auto fail = [&] (const std::string& what) {
+			err = std::string (path) + ":" + std::to_string (line_no) + ": " + what;
+			return (false);
+		};
+		if (! tokenize (line, tokens))
+			return (fail ("unterminated quote"));
+		if (tokens.empty ())
+			continue;
+		if (tokens [0] == "set") {
+			if (tokens.size () < 2)
+				return (fail ("set requires a name"));
+			param_set set {tokens [1], {}};
+			if (! parse_params (tokens, 2, set.params, msg))
+				return (fail (msg));
+			auto same = std::find_if (sets.begin (), sets.end (), [&set] (const param_set& s) {return (s.name == set.name);});
+			if (same != sets.end ())
+				*same = set;						// redefined
+			else
+				sets.push_back (set);
+			continue;
+		}
+		if (tokens.size () < 2)
+			return (fail ("output is missing"));
+		param_list params;
+		if (! parse_params (tokens, 2, params, msg))
+			return (fail (msg));
+		render_job job;
+		job.input = tokens [0];
+		job.output = tokens [1];
+		job.params = params;
+		if (job.output.find (SET_TAG) == std::string::npos) {
+			jobs.push_back (job);
+			continue;
+		}
+		if (sets.empty ())
+			return (fail ("no set is defined for " + SET_TAG));
+		for (const auto& set: sets) {
+			render_job set_job = job;
+			for (size_t at; (at = set_job.output.find (SET_TAG)) != std::string::npos;)
+				set_job.output.replace (at, SET_TAG.size (), set.name);
+			set_job.params = set.params;
+			set_job.params.insert (set_job.params.end (), params.begin (), params.end ());
+			jobs.push_back (set_job);
+		}
+	}
+	return (true);
+}
+
+// renders jobs of a manifest by a renderer for each worker
+
+int batch (const char* manifest, const param_list& params, const render_options& opt, const int workers)
+{
+	std::vector <render_job> jobs;
+	std::string err;
+	if (! read_manifest (manifest, jobs, err)) {
+		std::fprintf (stderr, "aq_render: %s\n", err.c_str ());
+		return (1);
+	}
+
+	// the longest processing time first, and the rest is balanced by stealing
+	std::vector <int> order (jobs.size ());
+	for (size_t i = 0; i < jobs.size (); i++) {
+		std::error_code ec;
+		jobs [i].params.insert (jobs [i].params.begin (), params.begin (), params.end ());
+		jobs [i].size = (long long)std::filesystem::file_size (jobs [i].input, ec);
+		order [i] = (int)i;
+	}
+	std::stable_sort (order.begin (), order.end (), [&jobs] (int a, int b) {return (jobs [a].size > jobs [b].size);});
+
+	// an output must not overwrite an input of any job, which may be mapped by another worker, and
+	// must not be written by two workers at once (the first job of an output renders it)
+	auto file_key = [] (const std::string& path) {
+		std::error_code ec;
+		std::filesystem::path key = std::filesystem::weakly_canonical (path, ec);
+		return (ec ? path : key.string ());
+	};
+	std::set <std::string> inputs;
+	for (const auto& job: jobs)
+		inputs.insert (file_key (job.input));
+	std::map <std::string, int> outputs;		// the first job of each output
+	for (size_t i = 0; i < jobs.size (); i++) {
+		const std::string key = file_key (jobs [i].output);
+		const auto [first, inserted] = outputs.emplace (key, (int)i);
+		if (inputs.count (key))
+			jobs [i].error = jobs [i].output + ": same file as an input of the manifest";
+		else if (! inserted)
+			jobs [i].error = jobs [i].output + ": same file as the output of job " + std::to_string (first->second + 1);
+	}
+
+	SOworkpool pool (workers);
+	std::vector <renderer> renderers (pool.workers ());
+	std::mutex report;
+	auto start = std::chrono::steady_clock::now ();
+	pool.run ((int)jobs.size (), [&] (const int worker, const int k) {
+		render_job& job = jobs [order [k]];
+		if (job.error.empty ())
+			renderers [worker].render (job, opt, false);
+		std::lock_guard <std::mutex> lock (report);
+		if (job.ok)
+			std::printf ("job %d: %s -> %s: %lld frames x %d ch, %.2f s in %.3f s (%.1f x real time)\n",
+				order [k] + 1, job.input.c_str (), job.output.c_str (), job.frames, job.channels, job.duration,
+				job.elapsed, job.elapsed > 0.0 ? job.duration / job.elapsed : 0.0);
+		else
+			std::fprintf (stderr, "aq_render: job %d: %s\n", order [k] + 1, job.error.c_str ());
+	});
+	double elapsed = std::chrono::duration <double> (std::chrono::steady_clock::now () - start).count ();
+
+	// real time factor of the batch, and of a worker by the sum of job times
+	int failed = 0;
+	double duration = 0.0;
+	double busy = 0.0;
+	for (const auto& job: jobs)
+		if (job.ok) {
+			duration += job.duration;
+			busy += job.elapsed;
+		} else
+			failed++;
+	std::fprintf (stderr, "aq_render: %zu jobs (%d failed) on %d workers, %.1f s of audio in %.2f s "
+		"(%.1f x real time, %.1f x per worker)\n", jobs.size (), failed, pool.workers (), duration, elapsed,
+		elapsed > 0.0 ? duration / elapsed : 0.0, busy > 0.0 ? duration / busy : 0.0);
+	return (failed ? 1 : 0);
+}
+
+} // namespace
+
+int main (int argc, char* argv [])
+{
+	// command line
+	param_list params;
+	render_options opt;
+	const char* manifest = nullptr;
+	int workers = 0;
+	const char* paths [2] = {nullptr, nullptr};
+	int num_paths = 0;
+	for (int i = 1; i < argc; i++) {
+		const char* arg = argv [i];
+		if (std::strncmp (arg, "--", 2) != 0) {
+			if (num_paths == 2) {
+				usage ();
+				return (2);
+			}
+			paths [num_paths++] = arg;
+			continue;
+		}
+		arg += 2;
+		if (std::strcmp (arg, "help") == 0) {
+			usage ();
+			return (0);
+		}
+		if (std::strcmp (arg, "tail") == 0) {
+			opt.tail = true;
+			continue;
+		}
+		if (i + 1 == argc) {
+			std::fprintf (stderr, "aq_render: --%s requires a value\n", arg);
+			return (2);
+		}
+		const char* val = argv [++i];
+		if (std::strcmp (arg, "format") == 0) {
+			for (const auto& f: sample_formats)
+				if (std::strcmp (val, f.name) == 0)
+					opt.format = &f;
+			if (! opt.format) {
+				std::fprintf (stderr, "aq_render: unknown format %s\n", val);
+				return (2);
+			}
+		} else if (std::strcmp (arg, "block") == 0) {
+			opt.block_len = std::atoi (val);
+			if (opt.block_len < 64 || opt.block_len > (1 << 24)) {
+				std::fprintf (stderr, "aq_render: --block must be 64 .. 16777216\n");
+				return (2);
+			}
+		} else if (std::strcmp (arg, "batch") == 0)
+			manifest = val;
+		else if (std::strcmp (arg, "workers") == 0) {
+			workers = std::atoi (val);
+			if (workers < 1) {
+				std::fprintf (stderr, "aq_render: --workers must be positive\n");
+				return (2);
+			}
+		} else {
+			const param_flag* flag = find_param_flag (arg);
+			double value;
+			if (! flag) {
+				std::fprintf (stderr, "aq_render: unknown flag --%s (see --help)\n", arg);
+				return (2);
+			}
+			if (! parse_param (*flag, val, value)) {
+				std::fprintf (stderr, "aq_render: invalid value of --%s: %s\n", arg, val);
+				return (2);
+			}
+			params.push_back ({flag, value});
+		}
+	}
+	if (manifest && num_paths == 0)
+		return (batch (manifest, params, opt, workers));
+	if (manifest || num_paths != 2) {
+		usage ();
+		return (2);
+	}
+
+	// a file, pipelined
+	render_job job;
+	job.input = paths [0];
+	job.output = paths [1];
+	job.params = params;
+	auto r = std::make_unique <renderer> ();
+	r->render (job, opt, true);
+	if (! job.ok) {
+		std::fprintf (stderr, "aq_render: %s\n", job.error.c_str ());
+		return (1);
+	}
+	std::fprintf (stderr, "aq_render: %lld frames x %d ch, %.1f s of audio in %.2f s (%.1f x real time)\n",
+		job.frames, job.channels, job.duration, job.elapsed, job.elapsed > 0.0 ? job.duration / job.elapsed : 0.0);
+	return (0);
+}
@@ -1,7 +1,7 @@
 //
 // Copyright (c) 2021-2023 suzumushi
 //
-// 2023-4-13		SO2ndordIIRfilters.h
+// 2026-10-17		SO2ndordIIRfilters.h
 //
 // Licensed under Creative Commons Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0).
 //
@@ -10,15 +10,30 @@
 
 #pragma once
 
+#include <cmath>
+#include <numbers>
+
 namespace suzumushi {
 
+// coefficients of a biquad filter, designed apart from the filter (e.g. in a background thread)
+
+template <typename TYPE>
+struct SObiquad_coefs {
+	TYPE a [3] = {0.0, 0.0, 0.0};		// feedback filter coefficients. a [0] is unused
+	TYPE b [3] = {0.0, 0.0, 0.0};		// feedforward filter coefficients
+	bool pass_through {false};			// pass through mode (SOLPF only)
+};
+
 // second-order IIR filter (biquad filter)
 
 template <typename TYPE>
 class SO2ndordIIRfilter {
 public:
 	virtual TYPE process (const TYPE xn);
+	void process (const TYPE* xn, TYPE* yn, const int len);		// xn and yn can be the same
 	virtual void reset ();
+	void set_coefs (const SObiquad_coefs <TYPE>& coefs);
+	SObiquad_coefs <TYPE> coefs () const;		// e.g. for SObiquads
 protected:
 	TYPE za [2] = {0.0, 0.0};			// delay registers for feedback filter
 	TYPE zb [2] = {0.0, 0.0};			// delay registers for feedforward filter
@@ -37,10 +52,50 @@ TYPE SO2ndordIIRfilter <TYPE>:: process (const TYPE xn)
 	return (yn);
 }
 
+template <typename TYPE>
+void SO2ndordIIRfilter <TYPE>:: process (const TYPE* xn, TYPE* yn, const int len)
+{
+	// non-virtual block processing with delay registers in local variables
+	TYPE za0 = za [0], za1 = za [1], zb0 = zb [0], zb1 = zb [1];
+	for (int i = 0; i < len; i++) {
+		TYPE x = xn [i];
+		TYPE y = b [0] * x + b [1] * zb0 + b [2] * zb1 + a [1] * za0 + a [2] * za1;
+		za1 = za0;
+		za0 = y;
+		zb1 = zb0;
+		zb0 = x;
+		yn [i] = y;
+	}
+	za [0] = za0;
+	za [1] = za1;
+	zb [0] = zb0;
+	zb [1] = zb1;
+}
+
 template <typename TYPE>
 inline void SO2ndordIIRfilter <TYPE>:: reset ()
 {
-	za [0] = za [1] = zb [0] = zb [0] = 0.0;
+	za [0] = za [1] = zb [0] = zb [1] = 0.0;
+}
+
+template <typename TYPE>
+inline void SO2ndordIIRfilter <TYPE>:: set_coefs (const SObiquad_coefs <TYPE>& coefs)
+{
+	for (int i = 0; i < 3; i++) {
+		a [i] = coefs.a [i];
+		b [i] = coefs.b [i];
+	}
+}
+
+template <typename TYPE>
+inline SObiquad_coefs <TYPE> SO2ndordIIRfilter <TYPE>:: coefs () const
+{
+	SObiquad_coefs <TYPE> coefs;
+	for (int i = 0; i < 3; i++) {
+		coefs.a [i] = a [i];
+		coefs.b [i] = b [i];
+	}
+	return (coefs);
 }
 
 
@@ -87,7 +142,11 @@ template <typename TYPE, TYPE FC_MAX = 20'000.0>
 class SOLPF: public SO2ndordIIRfilter <TYPE> {
 public:
 	void setup (const TYPE SR, const TYPE fc, const TYPE Q = 0.5);
+	static SObiquad_coefs <TYPE> design (const TYPE SR, const TYPE fc, const TYPE Q = 0.5);
+	static bool pass_through_at (const TYPE fc);
+	void set_coefs (const SObiquad_coefs <TYPE>& coefs);
 	TYPE process (const TYPE xn) override;
+	void process (const TYPE* xn, TYPE* yn, const int len);
 private:
 	bool pass_through {false};			// pass through mode
 };
@@ -95,19 +154,43 @@ private:
 template <typename TYPE, TYPE FC_MAX>
 void SOLPF <TYPE, FC_MAX>:: setup (const TYPE SR, const TYPE fc, const TYPE Q)
 {
-	if (fc >= FC_MAX) {
+	set_coefs (design (SR, fc, Q));
+}
+
+template <typename TYPE, TYPE FC_MAX>
+SObiquad_coefs <TYPE> SOLPF <TYPE, FC_MAX>:: design (const TYPE SR, const TYPE fc, const TYPE Q)
+{
+	SObiquad_coefs <TYPE> coefs;
+	if (fc >= FC_MAX) 
+		coefs.pass_through = true;
+	else {
+		TYPE omega_a = tan (std::numbers::pi * fc / SR);
+		TYPE omega_a_2 = pow (omega_a, 2.0);							// omega_a_2 = omega_a^2
+		TYPE omega_a_Q = omega_a / Q;									// omega_a_Q = omega_a / Q
+		coefs.a [0] = omega_a_2 + omega_a_Q + 1.0;						// a [0] = omega_a^2 + omega_a / Q + 1
+		coefs.a [1] = -2.0 * (omega_a_2 - 1.0) / coefs.a [0];			// a [1] = -2 * (omega_a^2 - 1) / a [0]
+		coefs.a [2] = - (omega_a_2 - omega_a_Q + 1.0) / coefs.a [0];	// a [2] = -(omega_a^2 - omega_a / Q + 1) / a [0]
+		coefs.b [0] = coefs.b [2] = omega_a_2 / coefs.a [0];			// b [0] = b_[2] = omega_a^2 / a [0]
+		coefs.b [1] = 2.0 * omega_a_2 / coefs.a [0];					// b [1] = 2 * omega_a^2 / a [0]
+	}
+	return (coefs);
+}
+
+template <typename TYPE, TYPE FC_MAX>
+bool SOLPF <TYPE, FC_MAX>:: pass_through_at (const TYPE fc)
+{
+	return (fc >= FC_MAX);
+}
+
+template <typename TYPE, TYPE FC_MAX>
+void SOLPF <TYPE, FC_MAX>:: set_coefs (const SObiquad_coefs <TYPE>& coefs)
+{
+	if (coefs.pass_through) {
 		pass_through = true;
 		this->reset ();
 	} else {
 		pass_through = false;
-		TYPE omega_a = tan (pi * fc / SR);
-		TYPE omega_a_2 = pow (omega_a, 2.0);							// omega_a_2 = omega_a^2
-		TYPE omega_a_Q = omega_a / Q;									// omega_a_Q = omega_a / Q
-		this->a [0] = omega_a_2 + omega_a_Q + 1.0;						// a [0] = omega_a^2 + omega_a / Q + 1
-		this->a [1] = -2.0 * (omega_a_2 - 1.0) / this->a [0];			// a [1] = -2 * (omega_a^2 - 1) / a [0]
-		this->a [2] = - (omega_a_2 - omega_a_Q + 1.0) / this->a [0];	// a [2] = -(omega_a^2 - omega_a / Q + 1) / a [0]
-		this->b [0] = this->b [2] = omega_a_2 / this->a [0];			// b [0] = b_[2] = omega_a^2 / a [0]
-		this->b [1] = 2.0 * omega_a_2 / this->a [0];					// b [1] = 2 * omega_a^2 / a [0]
+		SO2ndordIIRfilter <TYPE>:: set_coefs (coefs);
 	}
 }
 
@@ -120,33 +203,65 @@ TYPE SOLPF <TYPE, FC_MAX>:: process (const TYPE xn)
 		return (SO2ndordIIRfilter <TYPE>:: process (xn));
 }
 
-// HPF with initial mute mode (MUTE_LEN [ms])
+template <typename TYPE, TYPE FC_MAX>
+void SOLPF <TYPE, FC_MAX>:: process (const TYPE* xn, TYPE* yn, const int len)
+{
+	if (pass_through) {
+		if (xn != yn)
+			for (int i = 0; i < len; i++)
+				yn [i] = xn [i];
+	} else
+		SO2ndordIIRfilter <TYPE>:: process (xn, yn, len);
+}
+
+// HPF with initial mute mode (MUTE_LEN [ms], 0 for no mute)
 
 template <typename TYPE, int MUTE_LEN = 100>	
 class SOHPF: public SO2ndordIIRfilter <TYPE> {
 public:
 	void setup (const TYPE SR, const TYPE fc, const TYPE Q = 0.5);
+	static SObiquad_coefs <TYPE> design (const TYPE SR, const TYPE fc, const TYPE Q = 0.5);
+	void set_coefs (const TYPE SR, const SObiquad_coefs <TYPE>& coefs);
 	TYPE process (const TYPE xn) override;
+	void process (const TYPE* xn, TYPE* yn, const int len);
 	void reset () override;
 private:
-	bool mute {true};
+	bool mute {MUTE_LEN != 0};
 	int mute_timer {0};
+	int mute_samples {0};				// MUTE_LEN in samples
 };
 
 template <typename TYPE, int MUTE_LEN>
 void SOHPF <TYPE, MUTE_LEN>:: setup (const TYPE SR, const TYPE fc, const TYPE Q)
 {
-	if (mute && mute_timer == 0)
-		mute_timer = (int)(SR + 0.5) * MUTE_LEN / 1000;
+	set_coefs (SR, design (SR, fc, Q));
+}
 
-	TYPE omega_a = tan (pi * fc / SR);
+template <typename TYPE, int MUTE_LEN>
+SObiquad_coefs <TYPE> SOHPF <TYPE, MUTE_LEN>:: design (const TYPE SR, const TYPE fc, const TYPE Q)
+{
+	SObiquad_coefs <TYPE> coefs;
+	TYPE omega_a = tan (std::numbers::pi * fc / SR);
 	TYPE omega_a_2 = pow (omega_a, 2.0);								// omega_a_2 = omega_a^2
 	TYPE omega_a_Q = omega_a / Q;										// omega_a_Q = omega_a / Q
-	this->a [0] = omega_a_2 + omega_a_Q + 1.0;							// a [0] = omega_a^2 + omega_a / Q + 1
-	this->a [1] = -2.0 * (omega_a_2 - 1.0) / this->a [0];				// a [1] = -2 * (omega_a^2 - 1) / a [0]
-	this->a [2] = - (omega_a_2 - omega_a_Q + 1.0) / this->a [0];		// a [2] = -(omega_a^2 - omega_a / Q + 1) / a [0]
-	this->b [0] = this->b [2] = 1.0 / this->a [0];						// b [0] = b_[2] = 1 / a [0]
-	this->b [1] = -2.0 / this->a [0];									// b [1] = -2 / a [0]
+	coefs.a [0] = omega_a_2 + omega_a_Q + 1.0;							// a [0] = omega_a^2 + omega_a / Q + 1
+	coefs.a [1] = -2.0 * (omega_a_2 - 1.0) / coefs.a [0];				// a [1] = -2 * (omega_a^2 - 1) / a [0]
+	coefs.a [2] = - (omega_a_2 - omega_a_Q + 1.0) / coefs.a [0];		// a [2] = -(omega_a^2 - omega_a / Q + 1) / a [0]
+	coefs.b [0] = coefs.b [2] = 1.0 / coefs.a [0];						// b [0] = b_[2] = 1 / a [0]
+	coefs.b [1] = -2.0 / coefs.a [0];									// b [1] = -2 / a [0]
+	return (coefs);
+}
+
+template <typename TYPE, int MUTE_LEN>
+void SOHPF <TYPE, MUTE_LEN>:: set_coefs (const TYPE SR, const SObiquad_coefs <TYPE>& coefs)
+{
+	mute_samples = (int)(SR + 0.5) * MUTE_LEN / 1000;
+	if (mute && mute_timer == 0) {
+		mute_timer = mute_samples;
+		if (mute_timer == 0)
+			mute = false;
+	}
+	SO2ndordIIRfilter <TYPE>:: set_coefs (coefs);
 }
 
 template <typename TYPE, int MUTE_LEN>
@@ -161,10 +276,23 @@ TYPE SOHPF <TYPE, MUTE_LEN>:: process (const TYPE xn)
 		return (yn);
 }
 
+template <typename TYPE, int MUTE_LEN>
+void SOHPF <TYPE, MUTE_LEN>:: process (const TYPE* xn, TYPE* yn, const int len)
+{
+	SO2ndordIIRfilter <TYPE>:: process (xn, yn, len);
+	for (int i = 0; i < len && mute; i++) {
+		yn [i] = 0.0;
+		if (--mute_timer == 0)
+			mute = false;
+	}
+}
+
 template <typename TYPE, int MUTE_LEN>
 void SOHPF <TYPE, MUTE_LEN>:: reset ()
 {
-	mute = true;
+	// the timer restarts without setup (), which may be deferred to a background thread
+	mute = MUTE_LEN != 0;
+	mute_timer = mute_samples;
 	SO2ndordIIRfilter <TYPE>:: reset ();
 }
 
@@ -179,7 +307,7 @@ public:
 template <typename TYPE>
 void SOBPF_G <TYPE>:: setup (const TYPE SR, const TYPE fc, const TYPE Q)
 {
-	TYPE omega_a = tan (pi * fc / SR);
+	TYPE omega_a = tan (std::numbers::pi * fc / SR);
 	TYPE omega_a_2 = pow (omega_a, 2.0);								// omega_a_2 = omega_a^2
 	TYPE omega_a_Q = omega_a / Q;										// omega_a_Q = omega_a / Q
 	this->a [0] = omega_a_2 + omega_a_Q + 1.0;							// a [0] = omega_a^2 + omega_a / Q + 1
@@ -201,7 +329,7 @@ public:
 template <typename TYPE>
 void SOBPF_B <TYPE>:: setup (const TYPE SR, const TYPE fc, const TYPE Q)
 {
-	TYPE omega_a = tan (pi * fc / SR);
+	TYPE omega_a = tan (std::numbers::pi * fc / SR);
 	TYPE omega_a_2 = pow (omega_a, 2.0);								// omega_a_2 = omega_a^2
 	TYPE omega_a_Q = omega_a / Q;										// omega_a_Q = omega_a / Q
 	this->a [0] = omega_a_2 + omega_a_Q + 1.0;							// a [0] = omega_a^2 + omega_a / Q + 1
@@ -223,7 +351,7 @@ public:
 template <typename TYPE>
 void SOBPF_E <TYPE>:: setup (const TYPE SR, const TYPE fc, const TYPE Q)
 {
-	TYPE omega_a = tan (pi * fc / SR);
+	TYPE omega_a = tan (std::numbers::pi * fc / SR);
 	TYPE omega_a_2 = pow (omega_a, 2.0);								// omega_a_2 = omega_a^2
 	TYPE omega_a_Q2 = omega_a / pow (Q, 2.0);							// omega_a_Q2 = omega_a / Q^2
 	this->a [0] = omega_a_2 + omega_a_Q2 + 1.0;							// a [0] = omega_a^2 + omega_a / Q^2 + 1
@@ -245,7 +373,7 @@ public:
 template <typename TYPE>
 void SOPFE <TYPE>:: setup (const TYPE SR, const TYPE fc, const TYPE Q, const TYPE A)
 {
-	TYPE omega_a = tan (pi * fc / SR);
+	TYPE omega_a = tan (std::numbers::pi * fc / SR);
 	TYPE omega_a_2 = pow (omega_a, 2.0);								// omega_a_2 = omega_a^2
 	TYPE omega_a_AQ = omega_a / (A * Q);								// omega_a_AQ = omega_a / (AQ)
 	TYPE omega_a_A_Q = omega_a * A / Q;									// omega_a_A_Q = omega_a * A / Q
@@ -1,7 +1,7 @@
 //
 // Copyright (c) 2021-2023 suzumushi
 //
-// 2023-3-30		SODDL.h
+// 2026-10-17		SODDL.h
 //
 // Licensed under Creative Commons Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0).
 //
@@ -10,6 +10,8 @@
 
 #pragma once
 
+#include <span>
+
 namespace suzumushi {
 
 // Digital Delay Line
@@ -17,8 +19,21 @@ namespace suzumushi {
 template <typename TYPE, unsigned int N>
 class SODDL {
 public:
+	SODDL () = default;
+	SODDL (const SODDL& src)					// head points into its own delay_line
+	{
+		*this = src;
+	}
+	SODDL& operator= (const SODDL& src)
+	{
+		for (unsigned int i = 0; i < N; i++)
+			delay_line [i] = src.delay_line [i];
+		head = delay_line + (src.head - src.delay_line);
+		return (*this);
+	}
 	void add (const int at, const TYPE val);
 	void enqueue (const TYPE val);
+	void delay (const TYPE* xn, TYPE* yn, const int len, const int at);	// block of enqueue () and read (at)
 	TYPE dequeue ();
 	TYPE read (const int at) const;
 	TYPE read () const;
@@ -45,6 +60,15 @@ void SODDL <TYPE, N>:: enqueue (const TYPE val)
 		head = delay_line;
 }
 
+template <typename TYPE, unsigned int N>
+void SODDL <TYPE, N>:: delay (const TYPE* xn, TYPE* yn, const int len, const int at)
+{
+	for (int i = 0; i < len; i++) {
+		enqueue (xn [i]);
+		yn [i] = read (at);
+	}
+}
+
 template <typename TYPE, unsigned int N>
 TYPE SODDL <TYPE, N>:: dequeue ()
 {
@@ -78,4 +102,82 @@ void SODDL <TYPE, N>:: reset ()
 	head = delay_line;
 }
 
+// Mirrored Digital Delay Line
+//
+// Same API as SODDL, but each sample is written twice into a buffer of 2N, so that the latest N
+// samples are always contiguous. read (at) needs no wrap around, and window () exposes them as a
+// span for SIMD kernels, window () [at] == read (at) (the oldest first).
+
+template <typename TYPE, unsigned int N>
+class SOMDDL {
+public:
+	void add (const int at, const TYPE val);
+	void enqueue (const TYPE val);
+	void delay (const TYPE* xn, TYPE* yn, const int len, const int at);	// block of enqueue () and read (at)
+	TYPE dequeue ();
+	TYPE read (const int at) const
+	{
+		return (delay_line [head + at]);
+	}
+	TYPE read () const
+	{
+		return (delay_line [head]);
+	}
+	std::span <const TYPE, N> window () const	// the latest N samples
+	{
+		return (std::span <const TYPE, N> (delay_line + head, N));
+	}
+	std::span <const TYPE> window (const int len) const	// the latest len samples
+	{
+		return (std::span <const TYPE> (delay_line + head + N - len, len));
+	}
+	void reset ();
+private:
+	alignas (64) TYPE delay_line [2 * N] {};
+	unsigned int head {0};						// the oldest sample in delay_line [head .. head + N - 1]
+};
+
+template <typename TYPE, unsigned int N>
+void SOMDDL <TYPE, N>:: add (const int at, const TYPE val)
+{
+	unsigned int i = head + at;
+	delay_line [i] += val;
+	delay_line [i >= N ? i - N : i + N] += val;
+}
+
+template <typename TYPE, unsigned int N>
+void SOMDDL <TYPE, N>:: enqueue (const TYPE val)
+{
+	delay_line [head] = delay_line [head + N] = val;
+	if (++head == N)
+		head = 0;
+}
+
+template <typename TYPE, unsigned int N>
+void SOMDDL <TYPE, N>:: delay (const TYPE* xn, TYPE* yn, const int len, const int at)
+{
+	for (int i = 0; i < len; i++) {
+		enqueue (xn [i]);
+		yn [i] = read (at);
+	}
+}
+
+template <typename TYPE, unsigned int N>
+TYPE SOMDDL <TYPE, N>:: dequeue ()
+{
+	TYPE ret = delay_line [head];
+	delay_line [head] = delay_line [head + N] = 0.0;	// read then clear
+	if (++head == N)
+		head = 0;
+	return (ret);
+}
+
+template <typename TYPE, unsigned int N>
+void SOMDDL <TYPE, N>:: reset ()
+{
+	for (unsigned int i = 0; i < 2 * N; i++)
+		delay_line [i] = 0.0;
+	head = 0;
+}
+
 } // namespace suzumushi
@@ -0,0 +1,122 @@
+//
+// Copyright (c) 2026 suzumushi
+//
+// 2026-10-17		SOFFT.h
+//
+// Licensed under Creative Commons Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0).
+//
+// https://creativecommons.org/licenses/by-nc-sa/4.0/
+//
+
+#pragma once
+
+#include <complex>
+#include <numbers>
+
+
+namespace suzumushi {
+
+// Real input FFT (radix-2, N = 2^m)
+// N-point real transform is computed by N/2-point complex FFT and a post-processing butterfly.
+
+template <typename TYPE,
+	int N = 128,								// Transform length. N must be a power of 2.
+	int M = N / 2>								// Length of complex FFT (don't touch this)
+class SOrealFFT {
+public:
+	SOrealFFT ();
+	void forward (const TYPE* xn, std::complex <TYPE>* Xk);		// xn [N] -> Xk [N / 2 + 1]
+	void inverse (const std::complex <TYPE>* Xk, TYPE* xn);		// Xk [N / 2 + 1] -> xn [N], inverse of forward ()
+private:
+	void cfft (std::complex <TYPE>* zn, const bool inv) const;
+	std::complex <TYPE> W_TBL [M / 2];			// twiddle factors of complex FFT, exp (-2j * pi * k / M)
+	std::complex <TYPE> R_TBL [M / 2 + 1];		// twiddle factors of post-processing, exp (-2j * pi * k / N)
+	int BR_TBL [M];								// bit reversal table
+	std::complex <TYPE> zn [M];					// work area
+};
+
+template <typename TYPE, int N, int M>
+SOrealFFT <TYPE, N, M>::
+SOrealFFT ()
+{
+	static_assert (N >= 4 && (N & (N - 1)) == 0, "N must be a power of 2");
+
+	for (int k = 0; k < M / 2; k++)
+		W_TBL [k] = std::polar <TYPE> (1.0, -2.0 * std::numbers::pi * k / M);
+	for (int k = 0; k <= M / 2; k++)
+		R_TBL [k] = std::polar <TYPE> (1.0, -2.0 * std::numbers::pi * k / N);
+
+	// the reversal of i is that of i / 2 shifted right, with the lowest bit of i as the highest bit
+	BR_TBL [0] = 0;
+	for (int i = 1; i < M; i++)
+		BR_TBL [i] = BR_TBL [i >> 1] >> 1 | (i & 1) * (M >> 1);
+}
+
+template <typename TYPE, int N, int M>
+void
+SOrealFFT <TYPE, N, M>::
+cfft (std::complex <TYPE>* zn, const bool inv) const
+{
+	// bit reversal
+	for (int i = 0; i < M; i++)
+		if (i < BR_TBL [i])
+			std::swap (zn [i], zn [BR_TBL [i]]);
+
+	// decimation in time butterflies
+	for (int len = 2; len <= M; len <<= 1) {
+		int half = len / 2;
+		int step = M / len;
+		for (int i = 0; i < M; i += len)
+			for (int k = 0; k < half; k++) {
+				std::complex <TYPE> w = inv ? std::conj (W_TBL [k * step]) : W_TBL [k * step];
+				std::complex <TYPE> t = w * zn [i + k + half];
+				zn [i + k + half] = zn [i + k] - t;
+				zn [i + k] += t;
+			}
+	}
+}
+
+template <typename TYPE, int N, int M>
+void
+SOrealFFT <TYPE, N, M>::
+forward (const TYPE* xn, std::complex <TYPE>* Xk)
+{
+	// pack even samples into real part and odd samples into imaginary part
+	for (int i = 0; i < M; i++)
+		zn [i] = std::complex <TYPE> (xn [2 * i], xn [2 * i + 1]);
+	cfft (zn, false);
+
+	// separate the spectra of even and odd samples, then combine them
+	Xk [0] = std::complex <TYPE> (zn [0].real () + zn [0].imag (), 0.0);
+	Xk [M] = std::complex <TYPE> (zn [0].real () - zn [0].imag (), 0.0);
+	for (int k = 1; k < M; k++) {
+		std::complex <TYPE> Zc = std::conj (zn [M - k]);
+		std::complex <TYPE> Fe = (zn [k] + Zc) * (TYPE)0.5;
+		std::complex <TYPE> Fo = (zn [k] - Zc) * std::complex <TYPE> (0.0, -0.5);
+		Xk [k] = Fe + (k <= M / 2 ? R_TBL [k] : - std::conj (R_TBL [M - k])) * Fo;
+	}
+}
+
+template <typename TYPE, int N, int M>
+void
+SOrealFFT <TYPE, N, M>::
+inverse (const std::complex <TYPE>* Xk, TYPE* xn)
+{
+	// recombine the spectra of even and odd samples
+	for (int k = 0; k < M; k++) {
+		std::complex <TYPE> Xc = std::conj (Xk [M - k]);
+		std::complex <TYPE> Fe = (Xk [k] + Xc) * (TYPE)0.5;
+		std::complex <TYPE> Fo = (Xk [k] - Xc) * (TYPE)0.5 *
+			std::conj (k <= M / 2 ? R_TBL [k] : - std::conj (R_TBL [M - k]));
+		zn [k] = Fe + std::complex <TYPE> (0.0, 1.0) * Fo;
+	}
+	cfft (zn, true);
+
+	// unpack and scale
+	for (int i = 0; i < M; i++) {
+		xn [2 * i] = zn [i].real () / M;
+		xn [2 * i + 1] = zn [i].imag () / M;
+	}
+}
+
+} // namespace suzumushi
@@ -0,0 +1,154 @@
+//
+// Copyright (c) 2026 suzumushi
+//
+// 2026-10-16		SOSIMD.h
+//
+// Licensed under Creative Commons Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0).
+//
+// https://creativecommons.org/licenses/by-nc-sa/4.0/
+//
+
+#pragma once
+
+#include <type_traits>
+#if defined (__AVX512F__) || defined (__AVX2__) || defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <immintrin.h>
+#define SO_SIMD_SSE2
+#endif
+
+
+namespace suzumushi {
+
+// SIMD kernels
+//
+// The instruction set is selected at compile time: AVX-512 (__AVX512F__), AVX2 (__AVX2__ with FMA)
+// or SSE2 (baseline of x86-64). Other TYPEs and targets fall back to scalar code.
+// LEN must be a multiple of SO_SIMD_WIDTH, and arrays are accessed by unaligned loads.
+
+constexpr int SO_SIMD_WIDTH = 8;			// number of doubles in the widest vector
+
+// dot product of a [LEN] and b [LEN]
+
+template <typename TYPE, int LEN>
+inline TYPE SOdot (const TYPE* a, const TYPE* b)
+{
+	static_assert (LEN % SO_SIMD_WIDTH == 0, "LEN must be a multiple of SO_SIMD_WIDTH");
+
+	if constexpr (std::is_same_v <TYPE, double>) {
+#if defined (__AVX512F__)
+		__m512d acc0 = _mm512_setzero_pd ();
+		for (int i = 0; i < LEN; i += 8)
+			acc0 = _mm512_fmadd_pd (_mm512_loadu_pd (a + i), _mm512_loadu_pd (b + i), acc0);
+		return (_mm512_reduce_add_pd (acc0));
+#elif defined (__AVX2__)
+		__m256d acc0 = _mm256_setzero_pd ();
+		__m256d acc1 = _mm256_setzero_pd ();
+		for (int i = 0; i < LEN; i += 8) {
+			acc0 = _mm256_fmadd_pd (_mm256_loadu_pd (a + i), _mm256_loadu_pd (b + i), acc0);
+			acc1 = _mm256_fmadd_pd (_mm256_loadu_pd (a + i + 4), _mm256_loadu_pd (b + i + 4), acc1);
+		}
+		acc0 = _mm256_add_pd (acc0, acc1);
+		__m128d acc = _mm_add_pd (_mm256_castpd256_pd128 (acc0), _mm256_extractf128_pd (acc0, 1));
+		return (_mm_cvtsd_f64 (_mm_add_sd (acc, _mm_unpackhi_pd (acc, acc))));
+#elif defined (SO_SIMD_SSE2)
+		__m128d acc0 = _mm_setzero_pd ();
+		__m128d acc1 = _mm_setzero_pd ();
+		__m128d acc2 = _mm_setzero_pd ();
+		__m128d acc3 = _mm_setzero_pd ();
+		for (int i = 0; i < LEN; i += 8) {
+			acc0 = _mm_add_pd (acc0, _mm_mul_pd (_mm_loadu_pd (a + i), _mm_loadu_pd (b + i)));
+			acc1 = _mm_add_pd (acc1, _mm_mul_pd (_mm_loadu_pd (a + i + 2), _mm_loadu_pd (b + i + 2)));
+			acc2 = _mm_add_pd (acc2, _mm_mul_pd (_mm_loadu_pd (a + i + 4), _mm_loadu_pd (b + i + 4)));
+			acc3 = _mm_add_pd (acc3, _mm_mul_pd (_mm_loadu_pd (a + i + 6), _mm_loadu_pd (b + i + 6)));
+		}
+		__m128d acc = _mm_add_pd (_mm_add_pd (acc0, acc1), _mm_add_pd (acc2, acc3));
+		return (_mm_cvtsd_f64 (_mm_add_sd (acc, _mm_unpackhi_pd (acc, acc))));
+#endif
+	}
+
+	TYPE acc [4] = {0.0, 0.0, 0.0, 0.0};
+	for (int i = 0; i < LEN; i += 4)
+		for (int k = 0; k < 4; k++)
+			acc [k] += a [i + k] * b [i + k];
+	return ((acc [0] + acc [1]) + (acc [2] + acc [3]));
+}
+
+// dot products of a [LEN] and CH interleaved channels b [LEN * CH], i.e. yn [ch] = sum a [i] * b [i * CH + ch]
+// One load of a feeds all channels in SIMD lanes. CH = 2 and other even CH are vectorized.
+
+template <typename TYPE, int LEN, int CH>
+inline void SOdot_interleaved (const TYPE* a, const TYPE* b, TYPE* yn)
+{
+	static_assert (LEN % SO_SIMD_WIDTH == 0, "LEN must be a multiple of SO_SIMD_WIDTH");
+
+	if constexpr (CH == 1) {
+		yn [0] = SOdot <TYPE, LEN> (a, b);
+		return;
+	}
+	if constexpr (std::is_same_v <TYPE, double> && CH == 2) {
+#if defined (__AVX2__)
+		// [a0, a0, a1, a1] * [L0, R0, L1, R1]
+		__m256d acc0 = _mm256_setzero_pd ();
+		__m256d acc1 = _mm256_setzero_pd ();
+		__m256d acc2 = _mm256_setzero_pd ();
+		__m256d acc3 = _mm256_setzero_pd ();
+		for (int i = 0; i < LEN; i += 8) {
+			__m256d a01 = _mm256_permute_pd (_mm256_broadcast_pd ((const __m128d*)(a + i)), 0xC);
+			__m256d a23 = _mm256_permute_pd (_mm256_broadcast_pd ((const __m128d*)(a + i + 2)), 0xC);
+			__m256d a45 = _mm256_permute_pd (_mm256_broadcast_pd ((const __m128d*)(a + i + 4)), 0xC);
+			__m256d a67 = _mm256_permute_pd (_mm256_broadcast_pd ((const __m128d*)(a + i + 6)), 0xC);
+			acc0 = _mm256_fmadd_pd (a01, _mm256_loadu_pd (b + 2 * i), acc0);
+			acc1 = _mm256_fmadd_pd (a23, _mm256_loadu_pd (b + 2 * i + 4), acc1);
+			acc2 = _mm256_fmadd_pd (a45, _mm256_loadu_pd (b + 2 * i + 8), acc2);
+			acc3 = _mm256_fmadd_pd (a67, _mm256_loadu_pd (b + 2 * i + 12), acc3);
+		}
+		acc0 = _mm256_add_pd (_mm256_add_pd (acc0, acc1), _mm256_add_pd (acc2, acc3));
+		_mm_storeu_pd (yn, _mm_add_pd (_mm256_castpd256_pd128 (acc0), _mm256_extractf128_pd (acc0, 1)));
+		return;
+#elif defined (SO_SIMD_SSE2)
+		// [a0, a0] * [L0, R0]
+		__m128d acc0 = _mm_setzero_pd ();
+		__m128d acc1 = _mm_setzero_pd ();
+		__m128d acc2 = _mm_setzero_pd ();
+		__m128d acc3 = _mm_setzero_pd ();
+		for (int i = 0; i < LEN; i += 4) {
+			__m128d a01 = _mm_loadu_pd (a + i);
+			__m128d a23 = _mm_loadu_pd (a + i + 2);
+			acc0 = _mm_add_pd (acc0, _mm_mul_pd (_mm_unpacklo_pd (a01, a01), _mm_loadu_pd (b + 2 * i)));
+			acc1 = _mm_add_pd (acc1, _mm_mul_pd (_mm_unpackhi_pd (a01, a01), _mm_loadu_pd (b + 2 * i + 2)));
+			acc2 = _mm_add_pd (acc2, _mm_mul_pd (_mm_unpacklo_pd (a23, a23), _mm_loadu_pd (b + 2 * i + 4)));
+			acc3 = _mm_add_pd (acc3, _mm_mul_pd (_mm_unpackhi_pd (a23, a23), _mm_loadu_pd (b + 2 * i + 6)));
+		}
+		_mm_storeu_pd (yn, _mm_add_pd (_mm_add_pd (acc0, acc1), _mm_add_pd (acc2, acc3)));
+		return;
+#endif
+	}
+	if constexpr (std::is_same_v <TYPE, double> && CH % 2 == 0) {
+#if defined (SO_SIMD_SSE2)
+		// [a0, a0] * [ch0, ch1], [a0, a0] * [ch2, ch3], ...
+		__m128d acc0 [CH / 2];
+		__m128d acc1 [CH / 2];
+		for (int k = 0; k < CH / 2; k++)
+			acc0 [k] = acc1 [k] = _mm_setzero_pd ();
+		for (int i = 0; i < LEN; i += 2) {
+			__m128d a0 = _mm_set1_pd (a [i]);
+			__m128d a1 = _mm_set1_pd (a [i + 1]);
+			for (int k = 0; k < CH / 2; k++) {
+				acc0 [k] = _mm_add_pd (acc0 [k], _mm_mul_pd (a0, _mm_loadu_pd (b + i * CH + 2 * k)));
+				acc1 [k] = _mm_add_pd (acc1 [k], _mm_mul_pd (a1, _mm_loadu_pd (b + (i + 1) * CH + 2 * k)));
+			}
+		}
+		for (int k = 0; k < CH / 2; k++)
+			_mm_storeu_pd (yn + 2 * k, _mm_add_pd (acc0 [k], acc1 [k]));
+		return;
+#endif
+	}
+
+	for (int k = 0; k < CH; k++)
+		yn [k] = 0.0;
+	for (int i = 0; i < LEN; i++)
+		for (int k = 0; k < CH; k++)
+			yn [k] += a [i] * b [i * CH + k];
+}
+
+} // namespace suzumushi
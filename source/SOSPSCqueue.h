@@ -0,0 +1,58 @@
+//
+// Copyright (c) 2026 suzumushi
+//
+// 2026-10-17		SOSPSCqueue.h
+//
+// Licensed under Creative Commons Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0).
+//
+// https://creativecommons.org/licenses/by-nc-sa/4.0/
+//
+
+#pragma once
+
+#include <atomic>
+
+
+namespace suzumushi {
+
+// lock-free single producer single consumer queue
+//
+// push () is called only from one thread and pop () only from another one. Neither of them blocks,
+// allocates memory or makes a system call, so both can be called from a real-time audio thread.
+
+template <typename TYPE, 
+	int N = 8>									// Capacity. N must be a power of two.
+class SOSPSCqueue {
+public:
+	bool push (const TYPE& val);				// returns false if the queue is full
+	bool pop (TYPE& val);						// returns false if the queue is empty
+private:
+	static_assert ((N & (N - 1)) == 0, "N must be a power of two");
+	TYPE buf [N];
+	alignas (64) std::atomic <unsigned int> tail {0};	// written by the producer
+	alignas (64) std::atomic <unsigned int> head {0};	// written by the consumer
+};
+
+template <typename TYPE, int N>
+bool SOSPSCqueue <TYPE, N>:: push (const TYPE& val)
+{
+	unsigned int t = tail.load (std::memory_order_relaxed);
+	if (t - head.load (std::memory_order_acquire) == N)
+		return (false);
+	buf [t & (N - 1)] = val;
+	tail.store (t + 1, std::memory_order_release);
+	return (true);
+}
+
+template <typename TYPE, int N>
+bool SOSPSCqueue <TYPE, N>:: pop (TYPE& val)
+{
+	unsigned int h = head.load (std::memory_order_relaxed);
+	if (tail.load (std::memory_order_acquire) == h)
+		return (false);
+	val = buf [h & (N - 1)];
+	head.store (h + 1, std::memory_order_release);
+	return (true);
+}
+
+} // namespace suzumushi
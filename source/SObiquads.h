@@ -0,0 +1,202 @@
+//
+// Copyright (c) 2026 suzumushi
+//
+// 2026-10-17		SObiquads.h
+//
+// Licensed under Creative Commons Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0).
+//
+// https://creativecommons.org/licenses/by-nc-sa/4.0/
+//
+
+#pragma once
+
+#include <type_traits>
+#include <cmath>
+#include <climits>
+#include <cstdint>
+#include "SO2ndordIIRfilters.h"
+#include "SOSIMD.h"
+
+
+namespace suzumushi {
+
+// Multichannel cascade of biquad filters (transposed direct form II, non-virtual)
+//
+// SECTIONS biquad sections are cascaded in one loop, and CH channels share the coefficients of each
+// section and run in SIMD lanes (pairs of channels for double with SSE2 or later). The state registers
+// are laid out channel by channel for each section, and process () runs the first ch channels only.
+// Channels of cleared bits of active are skipped, and their states are kept until reset_channel ().
+// (A SIMD pair runs if either channel of it is active.)
+// Coefficients are produced by the designs of SO2ndordIIRfilters.h, i.e. SObiquad_coefs of
+// SOLPF::design (), SOHPF::design () or coefs () of SOBPF_G, SOBPF_B, SOBPF_E and SOPFE.
+// A pass through section (SOLPF) becomes the identity. mute () zeros the output of the next samples
+// while the sections keep running, same as the initial mute of SOHPF.
+// tail_samples () estimates the samples until the impulse response decays below decay, from the pole
+// radius of each section (the tails of cascaded sections are summed).
+
+template <typename TYPE, 
+	int CH = 2,									// number of channels
+	int SECTIONS = 1>							// number of cascaded sections
+class SObiquads {
+public:
+	SObiquads ();
+	void set_coefs (const int section, const SObiquad_coefs <TYPE>& coefs);
+	void process (const TYPE* const* xn, TYPE* const* yn, const int len, const int ch = CH,
+		const uint64_t active = ~(uint64_t)0);	// planar channels, xn and yn can be the same
+	void mute (const int samples);
+	void reset ();
+	void reset_channel (const int k);
+	void copy_channel (const int dst, const int src);		// state of channel src to dst
+	int tail_samples (const TYPE decay) const;
+private:
+	void section_reset (const int section);
+	TYPE b0 [SECTIONS], b1 [SECTIONS], b2 [SECTIONS];	// feedforward filter coefficients
+	TYPE a1 [SECTIONS], a2 [SECTIONS];					// feedback filter coefficients (sign of SObiquad_coefs)
+	alignas (16) TYPE s1 [SECTIONS][CH] {};				// state registers
+	alignas (16) TYPE s2 [SECTIONS][CH] {};
+	int mute_timer {0};							// remaining samples of mute
+};
+
+template <typename TYPE, int CH, int SECTIONS>
+SObiquads <TYPE, CH, SECTIONS>:: SObiquads ()
+{
+	for (int s = 0; s < SECTIONS; s++)
+		set_coefs (s, {.pass_through = true});
+}
+
+template <typename TYPE, int CH, int SECTIONS>
+void SObiquads <TYPE, CH, SECTIONS>:: set_coefs (const int section, const SObiquad_coefs <TYPE>& coefs)
+{
+	if (coefs.pass_through) {
+		b0 [section] = 1.0;
+		b1 [section] = b2 [section] = a1 [section] = a2 [section] = 0.0;
+		section_reset (section);
+	} else {
+		b0 [section] = coefs.b [0];
+		b1 [section] = coefs.b [1];
+		b2 [section] = coefs.b [2];
+		a1 [section] = coefs.a [1];
+		a2 [section] = coefs.a [2];
+	}
+}
+
+template <typename TYPE, int CH, int SECTIONS>
+void SObiquads <TYPE, CH, SECTIONS>:: process (const TYPE* const* xn, TYPE* const* yn, const int len, const int ch,
+	const uint64_t active)
+{
+	int k = 0;							// the next channel
+	if constexpr (std::is_same_v <TYPE, double>) {
+#if defined (SO_SIMD_SSE2)
+		// a pair of channels in a vector
+		for (; k + 1 < ch; k += 2) {
+			if (! (active >> k & 3))
+				continue;
+			__m128d B0 [SECTIONS], B1 [SECTIONS], B2 [SECTIONS], A1 [SECTIONS], A2 [SECTIONS], S1 [SECTIONS], S2 [SECTIONS];
+			for (int s = 0; s < SECTIONS; s++) {
+				B0 [s] = _mm_set1_pd (b0 [s]);
+				B1 [s] = _mm_set1_pd (b1 [s]);
+				B2 [s] = _mm_set1_pd (b2 [s]);
+				A1 [s] = _mm_set1_pd (a1 [s]);
+				A2 [s] = _mm_set1_pd (a2 [s]);
+				S1 [s] = _mm_load_pd (s1 [s] + k);
+				S2 [s] = _mm_load_pd (s2 [s] + k);
+			}
+			const TYPE* x0 = xn [k];
+			const TYPE* x1 = xn [k + 1];
+			TYPE* y0 = yn [k];
+			TYPE* y1 = yn [k + 1];
+			for (int i = 0; i < len; i++) {
+				__m128d v = _mm_set_pd (x1 [i], x0 [i]);
+				for (int s = 0; s < SECTIONS; s++) {
+					__m128d y = _mm_add_pd (_mm_mul_pd (B0 [s], v), S1 [s]);
+					S1 [s] = _mm_add_pd (_mm_add_pd (_mm_mul_pd (B1 [s], v), _mm_mul_pd (A1 [s], y)), S2 [s]);
+					S2 [s] = _mm_add_pd (_mm_mul_pd (B2 [s], v), _mm_mul_pd (A2 [s], y));
+					v = y;
+				}
+				_mm_storel_pd (y0 + i, v);
+				_mm_storeh_pd (y1 + i, v);
+			}
+			for (int s = 0; s < SECTIONS; s++) {
+				_mm_store_pd (s1 [s] + k, S1 [s]);
+				_mm_store_pd (s2 [s] + k, S2 [s]);
+			}
+		}
+#endif
+	}
+	for (; k < ch; k++) {
+		if (! (active >> k & 1))
+			continue;
+		const TYPE* x = xn [k];
+		TYPE* y = yn [k];
+		for (int i = 0; i < len; i++) {
+			TYPE v = x [i];
+			for (int s = 0; s < SECTIONS; s++) {
+				TYPE u = b0 [s] * v + s1 [s][k];
+				s1 [s][k] = b1 [s] * v + a1 [s] * u + s2 [s][k];
+				s2 [s][k] = b2 [s] * v + a2 [s] * u;
+				v = u;
+			}
+			y [i] = v;
+		}
+	}
+
+	for (int i = 0; i < len && mute_timer > 0; i++, mute_timer--)
+		for (int k = 0; k < ch; k++)
+			yn [k][i] = 0.0;
+}
+
+template <typename TYPE, int CH, int SECTIONS>
+void SObiquads <TYPE, CH, SECTIONS>:: mute (const int samples)
+{
+	mute_timer = samples;
+}
+
+template <typename TYPE, int CH, int SECTIONS>
+void SObiquads <TYPE, CH, SECTIONS>:: section_reset (const int section)
+{
+	for (int k = 0; k < CH; k++)
+		s1 [section][k] = s2 [section][k] = 0.0;
+}
+
+template <typename TYPE, int CH, int SECTIONS>
+void SObiquads <TYPE, CH, SECTIONS>:: reset ()
+{
+	for (int s = 0; s < SECTIONS; s++)
+		section_reset (s);
+	mute_timer = 0;
+}
+
+template <typename TYPE, int CH, int SECTIONS>
+void SObiquads <TYPE, CH, SECTIONS>:: reset_channel (const int k)
+{
+	for (int s = 0; s < SECTIONS; s++)
+		s1 [s][k] = s2 [s][k] = 0.0;
+}
+
+template <typename TYPE, int CH, int SECTIONS>
+void SObiquads <TYPE, CH, SECTIONS>:: copy_channel (const int dst, const int src)
+{
+	for (int s = 0; s < SECTIONS; s++) {
+		s1 [s][dst] = s1 [s][src];
+		s2 [s][dst] = s2 [s][src];
+	}
+}
+
+template <typename TYPE, int CH, int SECTIONS>
+int SObiquads <TYPE, CH, SECTIONS>:: tail_samples (const TYPE decay) const
+{
+	TYPE tail = 0.0;
+	for (int s = 0; s < SECTIONS; s++) {
+		// poles are the roots of z^2 - a1 z - a2
+		TYPE disc = a1 [s] * a1 [s] + 4.0 * a2 [s];
+		TYPE r = disc < 0.0 ? std::sqrt (- a2 [s]) : (std::abs (a1 [s]) + std::sqrt (disc)) / 2.0;
+		if (r >= 1.0)
+			return (INT_MAX);
+		tail += 2.0;							// feedforward
+		if (r > 0.0)
+			tail += std::log (decay) / std::log (r);
+	}
+	return (tail < INT_MAX ? (int)std::ceil (tail) : INT_MAX);
+}
+
+}	// namespace suzumushi
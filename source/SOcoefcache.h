@@ -0,0 +1,106 @@
+//
+// Copyright (c) 2026 suzumushi
+//
+// 2026-10-17		SOcoefcache.h
+//
+// Licensed under Creative Commons Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0).
+//
+// https://creativecommons.org/licenses/by-nc-sa/4.0/
+//
+
+#pragma once
+
+#include <atomic>
+#include <cmath>
+#include <memory>
+
+
+namespace suzumushi {
+
+// bounded cache of designed filter coefficients
+//
+// A cutoff frequency fc is quantized to the logarithmic grid F_MIN * 2^(n / STEPS) (n = 0 .. CAPACITY - 1),
+// and coefficients are designed at the grid frequency, so the error of the cutoff is within +/-1/(2 STEPS)
+// octave (+/-0.7% for STEPS = 48). Each grid point has one slot tagged with the sampling rate, so the
+// key is (sampling rate, quantized cutoff), and one cache is used for each filter type.
+// Cutoffs outside of the grid are designed at fc without being cached.
+// Not thread safe except for hits () and misses ().
+
+template <typename COEFS,
+	int CAPACITY = 512,							// number of grid points
+	int STEPS = 48>								// grid points per octave
+class SOcoef_cache {
+public:
+	static constexpr double F_MIN = 20.0;		// lowest grid frequency
+	SOcoef_cache ();
+	// design (COEFS& coefs, const double SR, const double fc) designs coefficients
+	template <typename DESIGN>
+	void get (COEFS& coefs, const double SR, const double fc, DESIGN design);
+	template <typename DESIGN>
+	void prewarm (const double SR, DESIGN design);	// fills all grid points below SR / 2
+	unsigned long long hits () const;
+	unsigned long long misses () const;
+private:
+	struct slot {
+		double SR {0.0};						// 0.0 for empty
+		COEFS coefs;
+	};
+	std::unique_ptr <slot []> slots;
+	std::atomic <unsigned long long> hit_count {0};
+	std::atomic <unsigned long long> miss_count {0};
+};
+
+template <typename COEFS, int CAPACITY, int STEPS>
+SOcoef_cache <COEFS, CAPACITY, STEPS>:: SOcoef_cache ()
+	: slots (new slot [CAPACITY])
+{}
+
+template <typename COEFS, int CAPACITY, int STEPS>
+template <typename DESIGN>
+void SOcoef_cache <COEFS, CAPACITY, STEPS>:: get (COEFS& coefs, const double SR, const double fc, DESIGN design)
+{
+	double n = fc > 0.0 ? std::round (STEPS * std::log2 (fc / F_MIN)) : -1.0;
+	if (n < 0.0 || n >= CAPACITY) {
+		miss_count.fetch_add (1, std::memory_order_relaxed);
+		design (coefs, SR, fc);
+		return;
+	}
+	slot& s = slots [(int)n];
+	if (s.SR == SR)
+		hit_count.fetch_add (1, std::memory_order_relaxed);
+	else {
+		miss_count.fetch_add (1, std::memory_order_relaxed);
+		design (s.coefs, SR, F_MIN * std::exp2 (n / STEPS));
+		s.SR = SR;
+	}
+	coefs = s.coefs;
+}
+
+template <typename COEFS, int CAPACITY, int STEPS>
+template <typename DESIGN>
+void SOcoef_cache <COEFS, CAPACITY, STEPS>:: prewarm (const double SR, DESIGN design)
+{
+	for (int n = 0; n < CAPACITY; n++) {
+		double fc = F_MIN * std::exp2 ((double)n / STEPS);
+		if (fc >= 0.5 * SR)
+			break;
+		if (slots [n].SR != SR) {
+			design (slots [n].coefs, SR, fc);
+			slots [n].SR = SR;
+		}
+	}
+}
+
+template <typename COEFS, int CAPACITY, int STEPS>
+unsigned long long SOcoef_cache <COEFS, CAPACITY, STEPS>:: hits () const
+{
+	return (hit_count.load (std::memory_order_relaxed));
+}
+
+template <typename COEFS, int CAPACITY, int STEPS>
+unsigned long long SOcoef_cache <COEFS, CAPACITY, STEPS>:: misses () const
+{
+	return (miss_count.load (std::memory_order_relaxed));
+}
+
+} // namespace suzumushi
@@ -0,0 +1,126 @@
+//
+// Copyright (c) 2026 suzumushi
+//
+// 2026-10-16		SOconstexprmath.h
+//
+// Licensed under Creative Commons Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0).
+//
+// https://creativecommons.org/licenses/by-nc-sa/4.0/
+//
+
+#pragma once
+
+#include <numbers>
+
+
+namespace suzumushi {
+
+// constexpr elementary functions for compile-time generation of tables
+// (<cmath> functions are not constexpr until C++26). Accuracy is within a few ulps of <cmath>
+// for the arguments used in tables, i.e. |x| <= 2 pi for sin and cos.
+
+namespace cx {
+
+constexpr double sqrt (const double x)
+{
+	if (x <= 0.0)
+		return (0.0);
+	// Newton's method decreasing monotonically from y >= sqrt (x)
+	double y = x > 1.0 ? x : 1.0;
+	for (;;) {
+		double next = 0.5 * (y + x / y);
+		if (next >= y)
+			return (y);
+		y = next;
+	}
+}
+
+constexpr double sin_poly (const double r)		// |r| <= pi/4
+{
+	double term = r;
+	double sum = r;
+	for (int n = 1; n <= 12; n++) {
+		term *= - r * r / ((2 * n) * (2 * n + 1));
+		sum += term;
+	}
+	return (sum);
+}
+
+constexpr double cos_poly (const double r)		// |r| <= pi/4
+{
+	double term = 1.0;
+	double sum = 1.0;
+	for (int n = 1; n <= 12; n++) {
+		term *= - r * r / ((2 * n - 1) * (2 * n));
+		sum += term;
+	}
+	return (sum);
+}
+
+constexpr long long quadrant (const double x)	// x = q * pi/2 + r, |r| <= pi/4
+{
+	double t = x / (std::numbers::pi / 2.0);
+	return ((long long)(t < 0.0 ? t - 0.5 : t + 0.5));
+}
+
+constexpr double sin (const double x)
+{
+	long long q = quadrant (x);
+	double r = x - q * (std::numbers::pi / 2.0);
+	switch (q & 3) {
+		case 0:
+			return (sin_poly (r));
+		case 1:
+			return (cos_poly (r));
+		case 2:
+			return (- sin_poly (r));
+		default:
+			return (- cos_poly (r));
+	}
+}
+
+constexpr double cos (const double x)
+{
+	long long q = quadrant (x);
+	double r = x - q * (std::numbers::pi / 2.0);
+	switch (q & 3) {
+		case 0:
+			return (cos_poly (r));
+		case 1:
+			return (- sin_poly (r));
+		case 2:
+			return (- cos_poly (r));
+		default:
+			return (sin_poly (r));
+	}
+}
+
+constexpr double log (double x)
+{
+	if (x <= 0.0)
+		return (- 1.0e300);
+	// x = m * 2^e, sqrt (1/2) <= m < sqrt (2)
+	int e = 0;
+	while (x >= std::numbers::sqrt2) {
+		x *= 0.5;
+		e++;
+	}
+	while (x < std::numbers::sqrt2 / 2.0) {
+		x *= 2.0;
+		e--;
+	}
+	// log (m) = 2 atanh ((m - 1) / (m + 1))
+	double s = (x - 1.0) / (x + 1.0);
+	double s2 = s * s;
+	double term = s;
+	double sum = 0.0;
+	for (int k = 0; k < 16; k++) {
+		sum += term / (2 * k + 1);
+		term *= s2;
+	}
+	return (2.0 * sum + e * std::numbers::ln2);
+}
+
+} // namespace cx
+
+} // namespace suzumushi
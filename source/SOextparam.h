@@ -1,7 +1,7 @@
 //
-// Copyright (c) 2021-2023 suzumushi
+// Copyright (c) 2021-2026 suzumushi
 //
-// 2023-9-1		SOextparam.h
+// 2026-10-17		SOextparam.h
 //
 // Licensed under Creative Commons Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0).
 //
@@ -10,7 +10,7 @@
 
 #pragma once
 
-#include <cmath>
+#include "SOparamdef.h"
 
 #include "public.sdk/source/vst/vsteditcontroller.h"
 using Steinberg::Vst::ParameterInfo;
@@ -20,75 +20,6 @@ using Steinberg::int32;
 using Steinberg::int16;
 
 
-namespace suzumushi {
-
-// precision of numerical parameters
-
-constexpr int32 precision0 {0};
-constexpr int32 precision1 {1};
-constexpr int32	precision2 {2};
-constexpr int32	precision3 {3};
-
-// templates for parameter definition
-
-struct rangeParameter {
-	ParamID tag;
-	ParamValue min;			// min plain
-	ParamValue max;			// max plain
-	ParamValue def;			// default value plain
-	int32 steps;			// step count
-	int32 flags;
-	// helper functions
-	static ParamValue toPlain (const ParamValue normalized, const rangeParameter range)
-	{
-		return (normalized * (range.max - range.min) + range.min);
-	}
-	static ParamValue toNormalized (const ParamValue plain, const rangeParameter range)
-	{
-		return ((plain - range.min) / (range.max - range.min));
-	}
-	static ParamValue dB_to_ratio (const ParamValue dB)
-	{
-		return (std::pow (10.0, dB / 20.0));
-	}
-	static ParamValue ratio_to_dB (const ParamValue ratio)
-	{
-		return (20.0 * std::log10 (ratio));
-	}
-};
-
-struct stringListParameter {
-	ParamID tag;
-	int32 flags;
-	// helper functions
-	static int32 toPlain (const ParamValue normalized, const int32 ListLength)
-	{
-		return ((int32)(normalized * (ListLength - 1) + 0.5));
-	}
-	static ParamValue toNormalized (const int32 plain, const int32 ListLength)
-	{
-		return ((ParamValue)(plain) / (ListLength - 1));
-	}
-};
-
-struct logTaperParameter {
-	ParamID tag;
-	ParamValue min;			// min plain
-	ParamValue max;			// max plain
-	ParamValue def;			// default value plain
-	int32 steps;			// step count
-	int32 flags;
-};
-
-struct infLogTaperParameter: public logTaperParameter {};
-
-struct infParameter: public rangeParameter {
-	bool min_inf;
-	bool max_inf;
-};
-
-} // namespace suzumushi
-
 //
 // Extended parameters 
 //
@@ -117,7 +48,7 @@ public:
 	// helper functions
 	static ParamValue toPlain (ParamValue normalized, ParamValue minPlain, ParamValue maxPlain)
 	{
-		return ((std::pow (81.0, normalized) - 1.0) / 80.0 * (maxPlain - minPlain) + minPlain);
+		return (suzumushi::logTaperParameter::toPlain (normalized, minPlain, maxPlain));
 	}
 	static ParamValue toPlain (const ParamValue normalized, const suzumushi::logTaperParameter range)
 	{
@@ -129,7 +60,7 @@ public:
 	// helper functions
 	static ParamValue toNormalized (ParamValue plainValue, ParamValue minPlain, ParamValue maxPlain)
 	{
-		return (std::log ((plainValue - minPlain) / (maxPlain - minPlain) * 80.0 + 1.0) / std::log (81.0));
+		return (suzumushi::logTaperParameter::toNormalized (plainValue, minPlain, maxPlain));
 	}
 	static ParamValue toNormalized (const ParamValue plainValue, const suzumushi::logTaperParameter range)
 	{
@@ -0,0 +1,125 @@
+//
+// Copyright (c) 2021-2026 suzumushi
+//
+// 2026-10-17		SOparamdef.h
+//
+// Licensed under Creative Commons Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0).
+//
+// https://creativecommons.org/licenses/by-nc-sa/4.0/
+//
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+
+namespace suzumushi {
+
+// types and flags of parameter definition, identical to those of the VST3 SDK
+// (but the SDK is not required)
+
+using int16 = std::int16_t;
+using int32 = std::int32_t;
+using uint32 = std::uint32_t;
+using int64 = std::int64_t;
+using uint64 = std::uint64_t;
+using ParamID = uint32;
+using ParamValue = double;
+
+struct ParameterInfo {
+	enum ParameterFlags: int32 {
+		kNoFlags = 0,
+		kCanAutomate = 1 << 0,
+		kIsReadOnly = 1 << 1,
+		kIsWrapAround = 1 << 2,
+		kIsList = 1 << 3,
+		kIsHidden = 1 << 4,
+		kIsProgramChange = 1 << 15,
+		kIsBypass = 1 << 16
+	};
+};
+
+// precision of numerical parameters
+
+constexpr int32 precision0 {0};
+constexpr int32 precision1 {1};
+constexpr int32	precision2 {2};
+constexpr int32	precision3 {3};
+
+// templates for parameter definition
+
+struct rangeParameter {
+	ParamID tag;
+	ParamValue min;			// min plain
+	ParamValue max;			// max plain
+	ParamValue def;			// default value plain
+	int32 steps;			// step count
+	int32 flags;
+	// helper functions
+	static ParamValue toPlain (const ParamValue normalized, const rangeParameter range)
+	{
+		return (normalized * (range.max - range.min) + range.min);
+	}
+	static ParamValue toNormalized (const ParamValue plain, const rangeParameter range)
+	{
+		return ((plain - range.min) / (range.max - range.min));
+	}
+	static ParamValue dB_to_ratio (const ParamValue dB)
+	{
+		return (std::pow (10.0, dB / 20.0));
+	}
+	static ParamValue ratio_to_dB (const ParamValue ratio)
+	{
+		return (20.0 * std::log10 (ratio));
+	}
+};
+
+struct stringListParameter {
+	ParamID tag;
+	int32 flags;
+	// helper functions
+	static int32 toPlain (const ParamValue normalized, const int32 ListLength)
+	{
+		return ((int32)(normalized * (ListLength - 1) + 0.5));
+	}
+	static ParamValue toNormalized (const int32 plain, const int32 ListLength)
+	{
+		return ((ParamValue)(plain) / (ListLength - 1));
+	}
+};
+
+struct logTaperParameter {
+	ParamID tag;
+	ParamValue min;			// min plain
+	ParamValue max;			// max plain
+	ParamValue def;			// default value plain
+	int32 steps;			// step count
+	int32 flags;
+	// helper functions of 10% logarithmic taper
+	static ParamValue toPlain (const ParamValue normalized, const ParamValue minPlain, const ParamValue maxPlain)
+	{
+		return ((std::pow (81.0, normalized) - 1.0) / 80.0 * (maxPlain - minPlain) + minPlain);
+	}
+	static ParamValue toPlain (const ParamValue normalized, const logTaperParameter range)
+	{
+		return (toPlain (normalized, range.min, range.max));
+	}
+	static ParamValue toNormalized (const ParamValue plain, const ParamValue minPlain, const ParamValue maxPlain)
+	{
+		return (std::log ((plain - minPlain) / (maxPlain - minPlain) * 80.0 + 1.0) / std::log (81.0));
+	}
+	static ParamValue toNormalized (const ParamValue plain, const logTaperParameter range)
+	{
+		return (toNormalized (plain, range.min, range.max));
+	}
+};
+
+struct infLogTaperParameter: public logTaperParameter {};
+
+struct infParameter: public rangeParameter {
+	bool min_inf;
+	bool max_inf;
+};
+
+} // namespace suzumushi
@@ -0,0 +1,382 @@
+//
+// Copyright (c) 2026 suzumushi
+//
+// 2026-10-17		SOwavfile.cpp
+//
+// Licensed under Creative Commons Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0).
+//
+// https://creativecommons.org/licenses/by-nc-sa/4.0/
+//
+
+#include "SOwavfile.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+namespace suzumushi {
+
+namespace {
+
+constexpr uint16_t WAVE_FORMAT_PCM = 0x0001;
+constexpr uint16_t WAVE_FORMAT_IEEE_FLOAT = 0x0003;
+constexpr uint16_t WAVE_FORMAT_EXTENSIBLE = 0xFFFE;
+// the rest of the sub format GUID of WAVE_FORMAT_EXTENSIBLE, after the format tag
+constexpr unsigned char KSDATAFORMAT_SUBTYPE [14] = {
+	0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0xAA, 0x00, 0x38, 0x9B, 0x71
+};
+
+template <typename T>
+T get (const unsigned char* p)
+{
+	T v;
+	std::memcpy (&v, p, sizeof (T));
+	return (v);
+}
+
+// headers are written into fixed-size arrays at known offsets, and at is advanced
+
+template <typename T, size_t N>
+void put (std::array <unsigned char, N>& h, size_t& at, const T x)
+{
+	std::memcpy (h.data () + at, &x, sizeof (T));
+	at += sizeof (T);
+}
+
+template <size_t N>
+void put_id (std::array <unsigned char, N>& h, size_t& at, const char* id)
+{
+	std::memcpy (h.data () + at, id, 4);
+	at += 4;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------
+// SOwav_reader
+//------------------------------------------------------------------------
+
+SOwav_reader:: ~SOwav_reader ()
+{
+	close ();
+}
+
+bool SOwav_reader:: open (const char* path)
+{
+	close ();
+#ifdef _WIN32
+	file = CreateFileA (path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		file = nullptr;
+		err = std::string ("cannot open ") + path;
+		return (false);
+	}
+	LARGE_INTEGER size;
+	if (! GetFileSizeEx (file, &size) || size.QuadPart == 0) {
+		err = std::string ("cannot map ") + path;
+		close ();
+		return (false);
+	}
+	mapping = CreateFileMappingA (file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping)
+		map = static_cast <const unsigned char*> (MapViewOfFile (mapping, FILE_MAP_READ, 0, 0, 0));
+	map_len = (size_t)size.QuadPart;
+#else
+	int fd = ::open (path, O_RDONLY);
+	if (fd < 0) {
+		err = std::string ("cannot open ") + path;
+		return (false);
+	}
+	struct stat st;
+	if (fstat (fd, &st) == 0 && st.st_size > 0) {
+		map_len = (size_t)st.st_size;
+		void* p = mmap (nullptr, map_len, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (p != MAP_FAILED) {
+			map = static_cast <const unsigned char*> (p);
+			madvise (p, map_len, MADV_SEQUENTIAL);	// read ahead aggressively, and drop pages behind
+		}
+	}
+	::close (fd);								// the mapping holds the file
+#endif
+	if (! map) {
+		err = std::string ("cannot map ") + path;
+		close ();
+		return (false);
+	}
+	if (! parse ()) {
+		close ();
+		return (false);
+	}
+	return (true);
+}
+
+void SOwav_reader:: close ()
+{
+#ifdef _WIN32
+	if (map)
+		UnmapViewOfFile (map);
+	if (mapping)
+		CloseHandle (mapping);
+	if (file)
+		CloseHandle (file);
+	mapping = file = nullptr;
+#else
+	if (map)
+		munmap (const_cast <unsigned char*> (map), map_len);
+#endif
+	map = data = nullptr;
+	map_len = 0;
+	data_frames = 0;
+}
+
+bool SOwav_reader:: parse ()
+{
+	err = "not a WAV or RF64 file";
+	if (map_len < 12 || std::memcmp (map + 8, "WAVE", 4) != 0)
+		return (false);
+	bool rf64 = std::memcmp (map, "RF64", 4) == 0;
+	if (! rf64 && std::memcmp (map, "RIFF", 4) != 0)
+		return (false);
+
+	unsigned long long data_size64 = 0;		// of ds64 chunk
+	bool has_fmt = false;
+	size_t pos = 12;
+	while (pos + 8 <= map_len) {
+		const unsigned char* chunk = map + pos;
+		unsigned long long size = get <uint32_t> (chunk + 4);
+		const unsigned char* body = chunk + 8;
+		size_t avail = map_len - pos - 8;
+
+		if (std::memcmp (chunk, "ds64", 4) == 0 && size >= 16 && avail >= 16) {
+			data_size64 = get <uint64_t> (body + 8);
+		} else if (std::memcmp (chunk, "fmt ", 4) == 0 && size >= 16 && avail >= 16) {
+			uint16_t tag = get <uint16_t> (body);
+			fmt.channels = get <uint16_t> (body + 2);
+			fmt.sampling_rate = get <uint32_t> (body + 4);
+			fmt.bits = get <uint16_t> (body + 14);
+			if (tag == WAVE_FORMAT_EXTENSIBLE && size >= 40 && avail >= 40)
+				tag = get <uint16_t> (body + 24);	// the first two bytes of the sub format GUID
+			fmt.is_float = tag == WAVE_FORMAT_IEEE_FLOAT;
+			bool supported = (tag == WAVE_FORMAT_PCM && (fmt.bits == 16 || fmt.bits == 24 || fmt.bits == 32)) ||
+				(tag == WAVE_FORMAT_IEEE_FLOAT && (fmt.bits == 32 || fmt.bits == 64));
+			if (! supported || fmt.channels == 0 || fmt.sampling_rate <= 0.0) {
+				err = "unsupported sample format (PCM 16, 24, 32 bits and IEEE float 32, 64 bits are supported)";
+				return (false);
+			}
+			has_fmt = true;
+		} else if (std::memcmp (chunk, "data", 4) == 0) {
+			if (! has_fmt) {
+				err = "data chunk precedes fmt chunk";
+				return (false);
+			}
+			if (rf64 && size == 0xFFFF'FFFF)
+				size = data_size64;
+			size = std::min <unsigned long long> (size, avail);	// truncated file
+			data = body;
+			data_frames = (long long)(size / fmt.frame_bytes ());
+			err.clear ();
+			return (true);
+		}
+		if (rf64 && size == 0xFFFF'FFFF)
+			break;
+		pos += 8 + size + (size & 1);			// chunks are word aligned
+	}
+	err = "no data chunk";
+	return (false);
+}
+
+void SOwav_reader:: read (const long long pos, const int len, double* const* yn) const
+{
+	const int ch = fmt.channels;
+	const int bytes = fmt.bits / 8;
+	const unsigned char* p = data + pos * fmt.frame_bytes ();
+
+	if (fmt.is_float && bytes == 4) {
+		for (int i = 0; i < len; i++)
+			for (int k = 0; k < ch; k++, p += 4)
+				yn [k][i] = get <float> (p);
+	} else if (fmt.is_float) {
+		for (int i = 0; i < len; i++)
+			for (int k = 0; k < ch; k++, p += 8)
+				yn [k][i] = get <double> (p);
+	} else if (bytes == 2) {
+		for (int i = 0; i < len; i++)
+			for (int k = 0; k < ch; k++, p += 2)
+				yn [k][i] = get <int16_t> (p) * (1.0 / 32'768.0);
+	} else if (bytes == 3) {
+		for (int i = 0; i < len; i++)
+			for (int k = 0; k < ch; k++, p += 3) {
+				int32_t v = (int32_t)((uint32_t)p [0] << 8 | (uint32_t)p [1] << 16 | (uint32_t)p [2] << 24);
+				yn [k][i] = (v >> 8) * (1.0 / 8'388'608.0);
+			}
+	} else {
+		for (int i = 0; i < len; i++)
+			for (int k = 0; k < ch; k++, p += 4)
+				yn [k][i] = get <int32_t> (p) * (1.0 / 2'147'483'648.0);
+	}
+}
+
+//------------------------------------------------------------------------
+// SOwav_writer
+//------------------------------------------------------------------------
+
+SOwav_writer:: ~SOwav_writer ()
+{
+	close ();
+}
+
+bool SOwav_writer:: open (const char* path, const SOwav_format& format)
+{
+	close ();
+	fmt = format;
+	data_bytes = 0;
+	fp = std::fopen (path, "wb");
+	if (! fp) {
+		err = std::string ("cannot create ") + path;
+		return (false);
+	}
+
+	// WAVE_FORMAT_EXTENSIBLE is required for more than 2 channels or more than 16 bits of PCM
+	const bool extensible = fmt.channels > 2 || (! fmt.is_float && fmt.bits > 16);
+	const uint16_t tag = fmt.is_float ? WAVE_FORMAT_IEEE_FLOAT : WAVE_FORMAT_PCM;
+	std::array <unsigned char, 12 + 8 + DS64_LEN + 8 + 40 + 8> h {};	// RIFF, JUNK, fmt and data headers
+	size_t at = 0;
+	put_id (h, at, "RIFF");
+	put <uint32_t> (h, at, 0);					// completed by close ()
+	put_id (h, at, "WAVE");
+	put_id (h, at, "JUNK");						// ds64 of RF64, if the file exceeds 4 GiB
+	put <uint32_t> (h, at, DS64_LEN);
+	at += DS64_LEN;								// zeros
+	put_id (h, at, "fmt ");
+	put <uint32_t> (h, at, extensible ? 40 : 16);
+	put <uint16_t> (h, at, extensible ? WAVE_FORMAT_EXTENSIBLE : tag);
+	put <uint16_t> (h, at, (uint16_t)fmt.channels);
+	put <uint32_t> (h, at, (uint32_t)(fmt.sampling_rate + 0.5));
+	put <uint32_t> (h, at, (uint32_t)(fmt.sampling_rate + 0.5) * fmt.frame_bytes ());
+	put <uint16_t> (h, at, (uint16_t)fmt.frame_bytes ());
+	put <uint16_t> (h, at, (uint16_t)fmt.bits);
+	if (extensible) {
+		put <uint16_t> (h, at, 22);				// cbSize
+		put <uint16_t> (h, at, (uint16_t)fmt.bits);	// valid bits
+		put <uint32_t> (h, at, 0);				// channel mask, unspecified
+		put <uint16_t> (h, at, tag);
+		std::memcpy (h.data () + at, KSDATAFORMAT_SUBTYPE, sizeof (KSDATAFORMAT_SUBTYPE));
+		at += sizeof (KSDATAFORMAT_SUBTYPE);
+	}
+	put_id (h, at, "data");
+	put <uint32_t> (h, at, 0);					// completed by close ()
+	header_len = (int)at;
+
+	if (std::fwrite (h.data (), 1, at, fp) != at) {
+		err = std::string ("cannot write ") + path;
+		std::fclose (fp);
+		fp = nullptr;
+		return (false);
+	}
+	return (true);
+}
+
+bool SOwav_writer:: write (const double* const* xn, const int len)
+{
+	if (! fp)
+		return (false);
+	const int ch = fmt.channels;
+	const int bytes = fmt.bits / 8;
+	buf.resize ((size_t)len * fmt.frame_bytes ());
+	unsigned char* p = buf.data ();
+
+	// PCM is rounded and saturated
+	auto pcm = [] (const double x, const double scale) {
+		return (std::clamp (std::nearbyint (x * scale), - scale, scale - 1.0));
+	};
+	if (fmt.is_float && bytes == 4) {
+		for (int i = 0; i < len; i++)
+			for (int k = 0; k < ch; k++, p += 4) {
+				float v = (float)xn [k][i];
+				std::memcpy (p, &v, 4);
+			}
+	} else if (fmt.is_float) {
+		for (int i = 0; i < len; i++)
+			for (int k = 0; k < ch; k++, p += 8)
+				std::memcpy (p, &xn [k][i], 8);
+	} else if (bytes == 2) {
+		for (int i = 0; i < len; i++)
+			for (int k = 0; k < ch; k++, p += 2) {
+				int16_t v = (int16_t)pcm (xn [k][i], 32'768.0);
+				std::memcpy (p, &v, 2);
+			}
+	} else if (bytes == 3) {
+		for (int i = 0; i < len; i++)
+			for (int k = 0; k < ch; k++, p += 3) {
+				int32_t v = (int32_t)pcm (xn [k][i], 8'388'608.0);
+				p [0] = (unsigned char)v;
+				p [1] = (unsigned char)(v >> 8);
+				p [2] = (unsigned char)(v >> 16);
+			}
+	} else {
+		for (int i = 0; i < len; i++)
+			for (int k = 0; k < ch; k++, p += 4) {
+				int32_t v = (int32_t)pcm (xn [k][i], 2'147'483'648.0);
+				std::memcpy (p, &v, 4);
+			}
+	}
+
+	if (std::fwrite (buf.data (), 1, buf.size (), fp) != buf.size ()) {
+		err = "write error";
+		return (false);
+	}
+	data_bytes += buf.size ();
+	return (true);
+}
+
+bool SOwav_writer:: close ()
+{
+	if (! fp)
+		return (false);
+	bool ok = true;
+	if (data_bytes & 1)
+		ok = std::fputc (0, fp) != EOF;			// pad byte of the data chunk
+
+	const unsigned long long riff_size = header_len - 8 + data_bytes + (data_bytes & 1);
+	std::array <unsigned char, 12 + 8 + DS64_LEN> h {};	// RIFF header, or RF64 header and ds64
+	size_t at = 0;
+	if (riff_size <= 0xFFFF'FFFF) {
+		put_id (h, at, "RIFF");
+		put <uint32_t> (h, at, (uint32_t)riff_size);
+	} else {
+		// RF64: sizes are in ds64, which replaces JUNK
+		put_id (h, at, "RF64");
+		put <uint32_t> (h, at, 0xFFFF'FFFF);
+		put_id (h, at, "WAVE");
+		put_id (h, at, "ds64");
+		put <uint32_t> (h, at, DS64_LEN);
+		put <uint64_t> (h, at, riff_size);
+		put <uint64_t> (h, at, data_bytes);
+		put <uint64_t> (h, at, data_bytes / fmt.frame_bytes ());
+		put <uint32_t> (h, at, 0);				// table length
+	}
+	ok = ok && std::fseek (fp, 0, SEEK_SET) == 0 && std::fwrite (h.data (), 1, at, fp) == at;
+
+	uint32_t data_size = data_bytes <= 0xFFFF'FFFF ? (uint32_t)data_bytes : 0xFFFF'FFFF;
+	ok = ok && std::fseek (fp, header_len - 4, SEEK_SET) == 0 && std::fwrite (&data_size, 4, 1, fp) == 1;
+	ok = std::fclose (fp) == 0 && ok;
+	fp = nullptr;
+	if (! ok)
+		err = "write error";
+	return (ok);
+}
+
+} // namespace suzumushi
@@ -0,0 +1,101 @@
+//
+// Copyright (c) 2026 suzumushi
+//
+// 2026-10-17		SOwavfile.h
+//
+// Licensed under Creative Commons Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0).
+//
+// https://creativecommons.org/licenses/by-nc-sa/4.0/
+//
+
+#pragma once
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+
+namespace suzumushi {
+
+// WAV and RF64 (EBU Tech 3306) files of PCM (16, 24 and 32 bits) and IEEE float (32 and 64 bits) samples
+//
+// SOwav_reader maps the whole file into memory, so that samples are read through the page cache
+// without copies or system calls. SOwav_writer writes blocks of interleaved samples with one fwrite ()
+// each. A JUNK chunk is reserved in front of the fmt chunk, and turned into the ds64 chunk of RF64 by
+// close (), if the file exceeds 4 GiB. Samples are converted from and to planar double in [-1, 1).
+// Hosts are assumed to be little endian.
+
+struct SOwav_format {
+	int channels {0};
+	double sampling_rate {0.0};
+	int bits {0};								// bits per sample
+	bool is_float {false};						// IEEE float, otherwise PCM
+	int frame_bytes () const
+	{
+		return (channels * bits / 8);
+	}
+};
+
+class SOwav_reader {
+public:
+	SOwav_reader () = default;
+	SOwav_reader (const SOwav_reader&) = delete;
+	SOwav_reader& operator= (const SOwav_reader&) = delete;
+	~SOwav_reader ();
+	bool open (const char* path);				// returns false with error ()
+	void close ();
+	const SOwav_format& format () const
+	{
+		return (fmt);
+	}
+	long long frames () const
+	{
+		return (data_frames);
+	}
+	void read (const long long pos, const int len, double* const* yn) const;	// planar, pos + len <= frames ()
+	const std::string& error () const
+	{
+		return (err);
+	}
+private:
+	bool parse ();
+	SOwav_format fmt;
+	const unsigned char* map {nullptr};			// whole file
+	size_t map_len {0};
+	const unsigned char* data {nullptr};		// samples of the data chunk
+	long long data_frames {0};
+	std::string err;
+#ifdef _WIN32
+	void* file {nullptr};						// HANDLE
+	void* mapping {nullptr};					// HANDLE
+#endif
+};
+
+class SOwav_writer {
+public:
+	SOwav_writer () = default;
+	SOwav_writer (const SOwav_writer&) = delete;
+	SOwav_writer& operator= (const SOwav_writer&) = delete;
+	~SOwav_writer ();
+	bool open (const char* path, const SOwav_format& format);	// returns false with error ()
+	bool write (const double* const* xn, const int len);	// planar
+	bool close ();								// completes the header
+	long long frames () const
+	{
+		return (data_bytes / fmt.frame_bytes ());
+	}
+	const std::string& error () const
+	{
+		return (err);
+	}
+private:
+	static constexpr int DS64_LEN = 28;			// ds64 chunk without a table
+	SOwav_format fmt;
+	FILE* fp {nullptr};
+	int header_len {0};							// up to the samples of the data chunk
+	long long data_bytes {0};
+	std::vector <unsigned char> buf;			// interleaved samples of a block
+	std::string err;
+};
+
+} // namespace suzumushi
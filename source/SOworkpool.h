@@ -0,0 +1,100 @@
+//
+// Copyright (c) 2026 suzumushi
+//
+// 2026-10-17		SOworkpool.h
+//
+// Licensed under Creative Commons Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0).
+//
+// https://creativecommons.org/licenses/by-nc-sa/4.0/
+//
+
+#pragma once
+
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace suzumushi {
+
+// work-stealing thread pool
+//
+// run () executes jobs 0 .. jobs - 1 and returns when all of them are done. Jobs are dealt round robin
+// to the deques of workers in the given order, so that the largest ones should come first. A worker
+// takes jobs from the front of its own deque, and when it gets empty, steals the back half of the
+// deque of another worker. Jobs are coarse (e.g. whole files) and never spawn jobs, so deques are
+// guarded by mutexes, and a worker quits when no deque has a job left.
+
+class SOworkpool {
+public:
+	explicit SOworkpool (const int workers = 0)	// 0: hardware concurrency
+	{
+		num_workers = workers > 0 ? workers : std::max ((int)std::thread::hardware_concurrency (), 1);
+		deques = std::make_unique <job_deque []> (num_workers);
+	}
+	int workers () const
+	{
+		return (num_workers);
+	}
+	template <typename F>
+	void run (const int jobs, F&& f);			// f (worker, job) in the threads of workers
+private:
+	struct alignas (64) job_deque {
+		std::mutex mutex;
+		std::deque <int> jobs;
+	};
+	int num_workers;
+	std::unique_ptr <job_deque []> deques;
+	bool take (const int worker, int& job);
+	bool steal (const int worker, int& job);
+};
+
+template <typename F>
+void SOworkpool:: run (const int jobs, F&& f)
+{
+	for (int i = 0; i < jobs; i++)
+		deques [i % num_workers].jobs.push_back (i);
+	std::vector <std::thread> threads;
+	for (int w = 0; w < num_workers; w++)
+		threads.emplace_back ([this, w, &f] () {
+			for (int job; take (w, job) || steal (w, job);)
+				f (w, job);
+		});
+	for (auto& t: threads)
+		t.join ();
+}
+
+inline bool SOworkpool:: take (const int worker, int& job)
+{
+	std::lock_guard <std::mutex> lock (deques [worker].mutex);
+	auto& jobs = deques [worker].jobs;
+	if (jobs.empty ())
+		return (false);
+	job = jobs.front ();
+	jobs.pop_front ();
+	return (true);
+}
+
+inline bool SOworkpool:: steal (const int worker, int& job)
+{
+	// victims are visited from the next worker, jobs in transit are run by the thief
+	std::vector <int> loot;
+	for (int i = 1; i < num_workers && loot.empty (); i++) {
+		job_deque& victim = deques [(worker + i) % num_workers];
+		std::lock_guard <std::mutex> lock (victim.mutex);
+		size_t half = (victim.jobs.size () + 1) / 2;
+		loot.assign (victim.jobs.end () - half, victim.jobs.end ());
+		victim.jobs.resize (victim.jobs.size () - half);
+	}
+	if (loot.empty ())
+		return (false);
+	job = loot.front ();
+	std::lock_guard <std::mutex> lock (deques [worker].mutex);
+	deques [worker].jobs.insert (deques [worker].jobs.end (), loot.begin () + 1, loot.end ());
+	return (true);
+}
+
+} // namespace suzumushi
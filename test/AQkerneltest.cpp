@@ -0,0 +1,205 @@
+//
+// Copyright (c) 2026 suzumushi
+//
+// 2026-10-17		AQkerneltest.cpp
+//
+// Licensed under Creative Commons Attribution-NonCommercial-ShareAlike 4.0 (CC BY-NC-SA 4.0).
+//
+// https://creativecommons.org/licenses/by-nc-sa/4.0/
+//
+
+// aq_kernel_test: equivalence of the optimized DSP kernels with their reference implementations
+//
+// The Hilbert transformers AQSIMDHilbert, AQMCHilbert and AQFFTHilbert are compared with AQHilbert of
+// the same impulse response on white noise, within HT_TOL (the output of a unit amplitude input is
+// a sum of a few hundred products, so rounding errors stay in the order of 1e-15).
+// The block generate () of AQDDS is compared with the per-sample process () bit for bit, for every
+// waveform, with naive and band-limited tables, and through frequency ramps.
+// The exit status is the number of failed checks.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "AQHilbert.h"
+#include "AQSIMDHilbert.h"
+#include "AQMCHilbert.h"
+#include "AQFFTHilbert.h"
+#include "AQDDS.h"
+#include "AQBLtables.h"
+
+using namespace suzumushi;
+
+constexpr double HT_TOL = 1e-13;				// tolerance of Hilbert transformers
+constexpr int SIG_LEN = 20'000;					// length of test signals
+constexpr int BLOCK_LENS [] = {1, 7, 64, 333, 1024};	// host block lengths, used in turn
+
+static int failures = 0;
+
+static void
+check (const bool ok, const char* name, const double err)
+{
+	std::fprintf (stderr, "%-44s %s (max error %.3g)\n", name, ok ? "ok" : "FAILED", err);
+	failures += !ok;
+}
+
+static std::vector <double>
+noise (const unsigned seed)
+{
+	std::mt19937 gen (seed);
+	std::uniform_real_distribution <double> dist (-1.0, 1.0);
+	std::vector <double> x (SIG_LEN);
+	for (double& v: x)
+		v = dist (gen);
+	return (x);
+}
+
+// reference output of AQHilbert, sample by sample
+
+template <int IR_LEN>
+static void
+reference (const std::vector <double>& x, std::vector <double>& y, std::vector <double>& yH)
+{
+	static AQHilbert <double, IR_LEN> HT;
+	HT.reset ();
+	y.resize (x.size ());
+	yH.resize (x.size ());
+	for (size_t i = 0; i < x.size (); i++)
+		HT.process (x [i], y [i], yH [i]);
+}
+
+static double
+max_error (const std::vector <double>& a, const std::vector <double>& b)
+{
+	double err = 0.0;
+	for (size_t i = 0; i < a.size (); i++)
+		err = std::max (err, std::abs (a [i] - b [i]));
+	return (err);
+}
+
+// single channel Hilbert transformers, processed in blocks of varying length and after reset ()
+
+template <typename HT, int IR_LEN>
+static void
+test_ht (const char* name)
+{
+	const std::vector <double> x = noise (IR_LEN);
+	std::vector <double> y_ref, yH_ref;
+	reference <IR_LEN> (x, y_ref, yH_ref);
+
+	static HT ht;
+	double err = 0.0;
+	for (int pass = 0; pass < 2; pass++) {
+		std::vector <double> y (SIG_LEN), yH (SIG_LEN);
+		ht.reset ();
+		for (int i = 0, b = 0; i < SIG_LEN; b++) {
+			int len = std::min (BLOCK_LENS [b % std::size (BLOCK_LENS)], SIG_LEN - i);
+			ht.process (&x [i], &y [i], &yH [i], len);
+			i += len;
+		}
+		err = std::max ({err, max_error (y, y_ref), max_error (yH, yH_ref)});
+	}
+	check (err <= HT_TOL, name, err);
+}
+
+// multichannel Hilbert transformer, each channel fed with its own signal
+
+template <int CH, int IR_LEN>
+static void
+test_mcht (const char* name)
+{
+	std::vector <double> x [CH], y_ref [CH], yH_ref [CH], y [CH], yH [CH];
+	for (int k = 0; k < CH; k++) {
+		x [k] = noise (IR_LEN + k);
+		reference <IR_LEN> (x [k], y_ref [k], yH_ref [k]);
+		y [k].resize (SIG_LEN);
+		yH [k].resize (SIG_LEN);
+	}
+
+	static AQMCHilbert <double, CH, IR_LEN> ht;
+	ht.reset ();
+	for (int i = 0, b = 0; i < SIG_LEN; b++) {
+		int len = std::min (BLOCK_LENS [b % std::size (BLOCK_LENS)], SIG_LEN - i);
+		const double* xp [CH];
+		double* yp [CH];
+		double* yHp [CH];
+		for (int k = 0; k < CH; k++) {
+			xp [k] = &x [k][i];
+			yp [k] = &y [k][i];
+			yHp [k] = &yH [k][i];
+		}
+		ht.process (xp, yp, yHp, len);
+		i += len;
+	}
+	double err = 0.0;
+	for (int k = 0; k < CH; k++)
+		err = std::max ({err, max_error (y [k], y_ref [k]), max_error (yH [k], yH_ref [k])});
+	check (err <= HT_TOL, name, err);
+}
+
+// AQDDS: block generate () against the per-sample process (), bit for bit
+
+static void
+test_dds (const char* name, const int waveform)
+{
+	static AQDDS <double> block, sample;
+	constexpr double SR = 48'000.0;
+	constexpr double freqs [] = {1.0, 440.0, 3'000.0, 15'000.0};
+
+	std::vector <double> y (SIG_LEN), yH (SIG_LEN);
+	double err = 0.0;
+	bool ok = true;
+	for (double f: freqs) {
+		block.reset ();
+		sample.reset ();
+		block.setup (SR, f);
+		sample.setup (SR, f);
+		block.set_phase (0.3);
+		sample.set_phase (0.3);
+		for (int i = 0, b = 0; i < SIG_LEN; b++) {
+			int len = std::min (BLOCK_LENS [b % std::size (BLOCK_LENS)], SIG_LEN - i);
+			if (b % 5 == 2) {						// ramps to another frequency, across blocks
+				block.ramp (f * 1.5, 500);
+				sample.ramp (f * 1.5, 500);
+			}
+			block.process (waveform, &y [i], &yH [i], len);
+			for (int j = i; j < i + len; j++) {
+				double ys, yHs;
+				sample.process (waveform, ys, yHs);
+				ok = ok && ys == y [j] && yHs == yH [j];
+				err = std::max ({err, std::abs (ys - y [j]), std::abs (yHs - yH [j])});
+			}
+			i += len;
+		}
+	}
+	check (ok, name, err);
+}
+
+int
+main ()
+{
+	test_ht <AQSIMDHilbert <double>, 259> ("AQSIMDHilbert (259) vs AQHilbert");
+	test_ht <AQSIMDHilbert <double, 771>, 771> ("AQSIMDHilbert (771) vs AQHilbert");
+	test_mcht <2, 259> ("AQMCHilbert (2 ch, 259) vs AQHilbert");
+	test_mcht <5, 771> ("AQMCHilbert (5 ch, 771) vs AQHilbert");
+	test_ht <AQFFTHilbert <double>, 771> ("AQFFTHilbert (771, 64) vs AQHilbert");
+	test_ht <AQFFTHilbert <double, 259, 16>, 259> ("AQFFTHilbert (259, 16) vs AQHilbert");
+	test_ht <AQFFTHilbert <double, 1539, 128>, 1539> ("AQFFTHilbert (1539, 128) vs AQHilbert");
+
+	const char* names [] = {"sine", "triangle", "square", "sawtooth"};
+	char name [64];
+	for (int w = (int)WFORM_L::SINE; w <= (int)WFORM_L::SAWTOOTH; w++) {
+		std::snprintf (name, sizeof (name), "AQDDS %s, naive tables", names [w]);
+		test_dds (name, w);
+	}
+	AQBLtables <double>::build ();
+	for (int w = (int)WFORM_L::SINE; w <= (int)WFORM_L::SAWTOOTH; w++) {
+		std::snprintf (name, sizeof (name), "AQDDS %s, band-limited tables", names [w]);
+		test_dds (name, w);
+	}
+
+	std::fprintf (stderr, failures ? "%d check(s) FAILED\n" : "all checks passed\n", failures);
+	return (failures);
+}